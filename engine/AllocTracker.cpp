@@ -0,0 +1,275 @@
+#include "AllocTracker.h"
+#include "Profiler.h"
+
+#include <atomic>
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+
+static std::atomic<uint64_t> totalAllocs{0};
+static std::atomic<uint64_t> totalFrees{0};
+static std::atomic<uint64_t> totalBytes{0};
+
+static AllocCheckConfig checkConfig;
+static std::atomic<bool> armed{false};
+static std::atomic<bool> exemptZones[MAX_PROFILE_ZONES];
+static std::atomic<uint64_t> frameViolations{0};
+static std::atomic<uint64_t> frameViolationBytes{0};
+static std::atomic<int> frameViolationZone{-1};
+// Só as threads do laço do jogo entram na verificação (renderização, log e recarga ficam de fora)
+static thread_local bool checkedThread = false;
+
+static uint64_t framesEnded = 0;
+static uint64_t framesChecked = 0;
+static uint64_t totalViolations = 0;
+static int steadyFrames = 0;
+
+static void reportViolation(int zone, size_t bytes)
+{
+    frameViolations.fetch_add(1, std::memory_order_relaxed);
+    frameViolationBytes.fetch_add(bytes, std::memory_order_relaxed);
+    int none = -1;
+    frameViolationZone.compare_exchange_strong(none, zone, std::memory_order_relaxed);
+
+    if (checkConfig.abortOnAlloc)
+    {
+        // snprintf em um buffer da pilha não aloca; printf para stdout/stderr poderia (buffer do FILE)
+        armed.store(false);
+        char message[160];
+        snprintf(message, sizeof(message), "alloc-check: %zu-byte allocation in steady state (zone %s)\n", bytes,
+                 profileZoneName(zone));
+        fputs(message, stderr);
+        abort();
+    }
+}
+
+static inline void recordAlloc(size_t bytes)
+{
+    totalAllocs.fetch_add(1, std::memory_order_relaxed);
+    totalBytes.fetch_add(bytes, std::memory_order_relaxed);
+
+    int zone = currentProfileZone();
+    ProfileZoneStats &stats = profileZoneStats(zone);
+    stats.allocs.fetch_add(1, std::memory_order_relaxed);
+    stats.allocBytes.fetch_add(bytes, std::memory_order_relaxed);
+
+    if (checkedThread && armed.load(std::memory_order_relaxed) && !exemptZones[zone].load(std::memory_order_relaxed))
+        reportViolation(zone, bytes);
+}
+
+static inline void recordFree()
+{
+    totalFrees.fetch_add(1, std::memory_order_relaxed);
+}
+
+#if defined(__GLIBC__)
+// Na glibc o executável sobrepõe malloc e família; a alocação real fica com as funções internas
+extern "C" void *__libc_malloc(size_t size);
+extern "C" void *__libc_calloc(size_t count, size_t size);
+extern "C" void *__libc_realloc(void *ptr, size_t size);
+extern "C" void __libc_free(void *ptr);
+extern "C" void *__libc_memalign(size_t alignment, size_t size);
+
+static inline void *rawMalloc(size_t size) { return __libc_malloc(size); }
+static inline void rawFree(void *ptr) { __libc_free(ptr); }
+
+extern "C" void *malloc(size_t size) noexcept
+{
+    void *ptr = __libc_malloc(size);
+    if (ptr)
+        recordAlloc(size);
+    return ptr;
+}
+
+extern "C" void *calloc(size_t count, size_t size) noexcept
+{
+    void *ptr = __libc_calloc(count, size);
+    if (ptr)
+        recordAlloc(count * size);
+    return ptr;
+}
+
+extern "C" void *realloc(void *ptr, size_t size) noexcept
+{
+    void *result = __libc_realloc(ptr, size);
+    if (result && size)
+        recordAlloc(size);
+    if (ptr && (result || size == 0))
+        recordFree();
+    return result;
+}
+
+extern "C" void free(void *ptr) noexcept
+{
+    if (ptr)
+        recordFree();
+    __libc_free(ptr);
+}
+
+// Variantes alinhadas: todas vão para __libc_memalign, e a memória volta por free()
+static inline void *rawAligned(size_t alignment, size_t size) { return __libc_memalign(alignment, size); }
+
+extern "C" void *memalign(size_t alignment, size_t size) noexcept
+{
+    void *ptr = __libc_memalign(alignment, size);
+    if (ptr)
+        recordAlloc(size);
+    return ptr;
+}
+
+extern "C" void *aligned_alloc(size_t alignment, size_t size) noexcept
+{
+    return memalign(alignment, size);
+}
+
+extern "C" int posix_memalign(void **result, size_t alignment, size_t size) noexcept
+{
+    // Potência de dois e múltiplo de sizeof(void *), como exige a especificação
+    if (alignment % sizeof(void *) != 0 || (alignment & (alignment - 1)) != 0)
+        return EINVAL;
+    void *ptr = memalign(alignment, size);
+    if (!ptr)
+        return ENOMEM;
+    *result = ptr;
+    return 0;
+}
+#else
+// Fora da glibc só operator new/delete são rastreados
+static inline void *rawMalloc(size_t size) { return std::malloc(size); }
+static inline void rawFree(void *ptr) { std::free(ptr); }
+static inline void *rawAligned(size_t alignment, size_t size) { return aligned_alloc(alignment, size); }
+#endif
+
+static inline void *trackedNew(size_t size)
+{
+    void *ptr = rawMalloc(size ? size : 1);
+    if (ptr)
+        recordAlloc(size);
+    return ptr;
+}
+
+static inline void *trackedAlignedNew(size_t size, std::align_val_t align)
+{
+    size_t alignment = (size_t)align;
+    size_t rounded = (size + alignment - 1) / alignment * alignment;
+    void *ptr = rawAligned(alignment, rounded ? rounded : alignment);
+    if (ptr)
+        recordAlloc(size);
+    return ptr;
+}
+
+static inline void trackedDelete(void *ptr)
+{
+    if (!ptr)
+        return;
+    recordFree();
+    rawFree(ptr);
+}
+
+void *operator new(size_t size)
+{
+    void *ptr = trackedNew(size);
+    if (!ptr)
+        throw std::bad_alloc();
+    return ptr;
+}
+
+void *operator new[](size_t size)
+{
+    void *ptr = trackedNew(size);
+    if (!ptr)
+        throw std::bad_alloc();
+    return ptr;
+}
+
+void *operator new(size_t size, const std::nothrow_t &) noexcept { return trackedNew(size); }
+void *operator new[](size_t size, const std::nothrow_t &) noexcept { return trackedNew(size); }
+
+void *operator new(size_t size, std::align_val_t align)
+{
+    void *ptr = trackedAlignedNew(size, align);
+    if (!ptr)
+        throw std::bad_alloc();
+    return ptr;
+}
+
+void *operator new[](size_t size, std::align_val_t align)
+{
+    void *ptr = trackedAlignedNew(size, align);
+    if (!ptr)
+        throw std::bad_alloc();
+    return ptr;
+}
+
+void operator delete(void *ptr) noexcept { trackedDelete(ptr); }
+void operator delete[](void *ptr) noexcept { trackedDelete(ptr); }
+void operator delete(void *ptr, size_t) noexcept { trackedDelete(ptr); }
+void operator delete[](void *ptr, size_t) noexcept { trackedDelete(ptr); }
+void operator delete(void *ptr, const std::nothrow_t &) noexcept { trackedDelete(ptr); }
+void operator delete[](void *ptr, const std::nothrow_t &) noexcept { trackedDelete(ptr); }
+
+// Memória de aligned_alloc é liberada com free()
+void operator delete(void *ptr, std::align_val_t) noexcept { trackedDelete(ptr); }
+void operator delete[](void *ptr, std::align_val_t) noexcept { trackedDelete(ptr); }
+void operator delete(void *ptr, size_t, std::align_val_t) noexcept { trackedDelete(ptr); }
+void operator delete[](void *ptr, size_t, std::align_val_t) noexcept { trackedDelete(ptr); }
+
+AllocCounters allocTotals()
+{
+    return {totalAllocs.load(), totalFrees.load(), totalBytes.load()};
+}
+
+void allocCheckSetup(const AllocCheckConfig &config)
+{
+    checkConfig = config;
+    steadyFrames = 0;
+    armed.store(false);
+}
+
+void allocCheckThread()
+{
+    checkedThread = true;
+}
+
+void allocCheckExemptZone(int zoneId)
+{
+    if (zoneId >= 0 && zoneId < MAX_PROFILE_ZONES)
+        exemptZones[zoneId].store(true);
+}
+
+void allocCheckEndFrame(bool steadyState)
+{
+    framesEnded++;
+    if (!checkConfig.enabled)
+        return;
+
+    // Desarma antes de imprimir: o próprio relatório pode alocar
+    bool wasArmed = armed.exchange(false);
+    if (wasArmed)
+        framesChecked++;
+
+    uint64_t violations = frameViolations.exchange(0);
+    uint64_t bytes = frameViolationBytes.exchange(0);
+    int zone = frameViolationZone.exchange(-1);
+    if (violations)
+    {
+        totalViolations += violations;
+        printf("alloc-check: frame %llu: %llu allocation(s), %llu bytes in steady state (first in zone %s)\n",
+               (unsigned long long)framesEnded, (unsigned long long)violations, (unsigned long long)bytes,
+               profileZoneName(zone));
+    }
+
+    steadyFrames = steadyState ? steadyFrames + 1 : 0;
+    armed.store(steadyFrames >= checkConfig.warmupFrames);
+}
+
+void allocCheckPrintSummary()
+{
+    AllocCounters totals = allocTotals();
+    printf("Allocations: %llu allocs, %llu frees, %llu bytes requested\n", (unsigned long long)totals.allocs,
+           (unsigned long long)totals.frees, (unsigned long long)totals.bytes);
+    if (checkConfig.enabled)
+        printf("alloc-check: %llu steady-state frames checked, %llu violation(s)\n", (unsigned long long)framesChecked,
+               (unsigned long long)totalViolations);
+}
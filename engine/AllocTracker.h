@@ -0,0 +1,35 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+// Rastreamento de alocações: operator new/delete (e malloc/calloc/realloc/free e as variantes
+// alinhadas na glibc) contam cada alocação na zona de profiling ativa (ver Profiler.h).
+
+struct AllocCounters
+{
+    uint64_t allocs;
+    uint64_t frees;
+    uint64_t bytes;
+};
+
+AllocCounters allocTotals();
+
+// Verificação de regime permanente: depois de warmupFrames frames seguidos em regime
+// (ex.: RUNNING), qualquer alocação fora das zonas isentas é uma violação.
+struct AllocCheckConfig
+{
+    bool enabled = false;
+    int warmupFrames = 120;
+    bool abortOnAlloc = false; // aborta na hora em vez de relatar no fim do frame
+};
+
+void allocCheckSetup(const AllocCheckConfig &config);
+// A thread chamadora entra na verificação (laço do jogo e workers do grafo); as outras (renderização,
+// escrita do log, recarga a quente) têm alocações próprias e só aparecem nas contagens
+void allocCheckThread();
+// Zonas que chamam código de terceiros (driver, GLFW) e não entram na verificação
+void allocCheckExemptZone(int zoneId);
+// Chamado no fim de cada frame; steadyState diz se o frame estava em regime permanente
+void allocCheckEndFrame(bool steadyState);
+void allocCheckPrintSummary();
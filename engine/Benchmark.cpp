@@ -0,0 +1,103 @@
+#include "Benchmark.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <ctime>
+
+double monotonicSeconds()
+{
+    using namespace std::chrono;
+    return duration<double>(steady_clock::now().time_since_epoch()).count();
+}
+
+double threadCpuSeconds()
+{
+#if defined(CLOCK_THREAD_CPUTIME_ID)
+    timespec ts;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+#else
+    // Sem relógio por thread: usa o tempo de CPU do processo
+    return (double)std::clock() / CLOCKS_PER_SEC;
+#endif
+}
+
+double percentile(std::vector<double> &samples, double p)
+{
+    if (samples.empty())
+        return 0.0;
+
+    // Método do posto mais próximo
+    size_t rank = (size_t)std::ceil(p / 100.0 * samples.size());
+    rank = std::min(std::max(rank, (size_t)1), samples.size());
+    std::nth_element(samples.begin(), samples.begin() + (rank - 1), samples.end());
+    return samples[rank - 1];
+}
+
+void BenchmarkRecorder::begin(int meteors, int expectedFrames)
+{
+    this->meteors = meteors;
+    frameMs.clear();
+    frameMs.reserve(expectedFrames);
+    runningFrames = 0;
+    restarts = 0;
+    culledSprites = 0;
+    wallStart = monotonicSeconds();
+    cpuStart = threadCpuSeconds();
+}
+
+void BenchmarkRecorder::frame(double ms, bool running, size_t culled)
+{
+    frameMs.push_back(ms);
+    culledSprites += culled;
+    if (running)
+        runningFrames++;
+}
+
+BenchmarkResult BenchmarkRecorder::finish()
+{
+    double wall = monotonicSeconds() - wallStart;
+    double cpu = threadCpuSeconds() - cpuStart;
+
+    BenchmarkResult result;
+    result.meteors = meteors;
+    result.frames = (int)frameMs.size();
+    result.restarts = restarts;
+    if (frameMs.empty())
+        return result;
+
+    double total = 0.0;
+    for (double ms : frameMs)
+        total += ms;
+
+    result.fps = wall > 0.0 ? result.frames / wall : 0.0;
+    result.avgFrameMs = total / result.frames;
+    result.cpuMsPerFrame = cpu * 1000.0 / result.frames;
+    result.runningRatio = (double)runningFrames / result.frames;
+    result.culledPerFrame = (double)culledSprites / result.frames;
+    result.p50FrameMs = percentile(frameMs, 50.0);
+    result.p99FrameMs = percentile(frameMs, 99.0);
+    return result;
+}
+
+void printBenchmarkResult(const BenchmarkResult &r)
+{
+    printf("Benchmark: %d meteors, %d frames\n", r.meteors, r.frames);
+    printf("  frames/s          %10.1f\n", r.fps);
+    printf("  frame ms avg      %10.3f\n", r.avgFrameMs);
+    printf("  frame ms p50      %10.3f\n", r.p50FrameMs);
+    printf("  frame ms p99      %10.3f\n", r.p99FrameMs);
+    printf("  CPU ms/frame      %10.3f\n", r.cpuMsPerFrame);
+    printf("  restarts          %10d  (RUNNING in %.1f%% of frames)\n", r.restarts, r.runningRatio * 100.0);
+    printf("  culled/frame      %10.1f  meteor sprites outside the view\n", r.culledPerFrame);
+}
+
+void printScalingCurve(const std::vector<BenchmarkResult> &results)
+{
+    printf("meteors,frames_per_s,avg_ms,p50_ms,p99_ms,cpu_ms_per_frame,restarts,running_ratio,culled_per_frame\n");
+    for (const BenchmarkResult &r : results)
+        printf("%d,%.1f,%.3f,%.3f,%.3f,%.3f,%d,%.3f,%.1f\n", r.meteors, r.fps, r.avgFrameMs, r.p50FrameMs,
+               r.p99FrameMs, r.cpuMsPerFrame, r.restarts, r.runningRatio, r.culledPerFrame);
+}
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Configuração do modo benchmark (--benchmark)
+struct BenchmarkConfig
+{
+    bool enabled = false;
+    bool offscreen = false;  // contexto OSMesa na plataforma nula da GLFW (sem GPU / sem display)
+    int frames = 1000;       // frames medidos por execução
+    int warmupFrames = 10;   // frames descartados antes da medição
+    int meteors = 5;         // quantidade de meteoros da execução única
+    unsigned int seed = 42;  // semente fixa do rand()
+    std::vector<int> sweep;  // quantidades de meteoros para a curva de escala
+};
+
+// Resultado de uma execução do benchmark
+struct BenchmarkResult
+{
+    int meteors = 0;
+    int frames = 0;
+    double fps = 0.0;
+    double avgFrameMs = 0.0;
+    double p50FrameMs = 0.0;
+    double p99FrameMs = 0.0;
+    double cpuMsPerFrame = 0.0;
+    int restarts = 0;           // quantas vezes o piloto automático bateu e reiniciou
+    double runningRatio = 0.0;  // fração dos frames medidos no estado RUNNING
+    double culledPerFrame = 0.0; // meteoros fora da tela descartados antes do envio, por frame
+};
+
+// Coleta os tempos de frame de uma execução
+class BenchmarkRecorder
+{
+public:
+    void begin(int meteors, int expectedFrames);
+    void frame(double frameMs, bool running, size_t culledSprites);
+    void restart() { restarts++; }
+    BenchmarkResult finish();
+
+private:
+    std::vector<double> frameMs;
+    int meteors = 0;
+    int runningFrames = 0;
+    int restarts = 0;
+    uint64_t culledSprites = 0;
+    double wallStart = 0.0;
+    double cpuStart = 0.0;
+};
+
+// Relógio monotônico e tempo de CPU da thread atual, em segundos
+double monotonicSeconds();
+double threadCpuSeconds();
+
+// Percentil (0-100) de um conjunto de amostras; reordena o vetor
+double percentile(std::vector<double> &samples, double p);
+
+void printBenchmarkResult(const BenchmarkResult &result);
+void printScalingCurve(const std::vector<BenchmarkResult> &results);
@@ -0,0 +1,220 @@
+#include "CommandCapture.h"
+
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+#include <mutex>
+
+static const char TRACE_MAGIC[8] = {'S', 'P', 'R', 'T', 'R', 'A', 'C', 'E'};
+
+static FILE *traceFile = nullptr;
+static std::atomic<bool> capturing{false};
+static std::mutex captureMutex;
+
+template <typename T>
+static void put(const T &value)
+{
+    fwrite(&value, sizeof(T), 1, traceFile);
+}
+
+bool captureOpen(const char *path, float viewWidth, float viewHeight)
+{
+    std::lock_guard<std::mutex> lock(captureMutex);
+    traceFile = fopen(path, "wb");
+    if (!traceFile)
+    {
+        printf("Cannot open capture file %s\n", path);
+        return false;
+    }
+    // Buffer grande: a gravação de um frame vira poucas escritas no disco
+    setvbuf(traceFile, nullptr, _IOFBF, 1 << 20);
+
+    TraceFileHeader header;
+    memcpy(header.magic, TRACE_MAGIC, sizeof(header.magic));
+    header.version = TRACE_VERSION;
+    header.viewWidth = viewWidth;
+    header.viewHeight = viewHeight;
+    put(header);
+    capturing = true;
+    return true;
+}
+
+bool captureActive()
+{
+    return capturing.load(std::memory_order_relaxed);
+}
+
+void captureTexture(GLuint id, int width, int height, const std::string &path)
+{
+    if (!captureActive())
+        return;
+    std::lock_guard<std::mutex> lock(captureMutex);
+    put((uint8_t)TRACE_TEXTURE);
+    put((uint32_t)id);
+    put((int32_t)width);
+    put((int32_t)height);
+    put((uint16_t)path.size());
+    fwrite(path.data(), 1, path.size(), traceFile);
+}
+
+void captureGeometry(GLuint vao, const float *vertices, int floatCount)
+{
+    if (!captureActive())
+        return;
+    std::lock_guard<std::mutex> lock(captureMutex);
+    put((uint8_t)TRACE_GEOMETRY);
+    put((uint32_t)vao);
+    put((uint32_t)floatCount);
+    fwrite(vertices, sizeof(float), floatCount, traceFile);
+}
+
+void captureState(bool blend, GLenum blendSrc, GLenum blendDst, GLenum depthFunc)
+{
+    if (!captureActive())
+        return;
+    std::lock_guard<std::mutex> lock(captureMutex);
+    put((uint8_t)TRACE_STATE);
+    put((uint8_t)(blend ? 1 : 0));
+    put((uint32_t)blendSrc);
+    put((uint32_t)blendDst);
+    put((uint32_t)depthFunc);
+}
+
+void captureFrame(const FrameSnapshot &frame)
+{
+    if (!captureActive())
+        return;
+    std::lock_guard<std::mutex> lock(captureMutex);
+    put((uint8_t)TRACE_FRAME);
+    put((uint32_t)frame.frame);
+    put(frame.time);
+    put(frame.backgroundScroll);
+    put((uint32_t)frame.sprites.size());
+    for (const SpriteDraw &spr : frame.sprites)
+    {
+        TraceDraw draw = {spr.texID,
+                          spr.VAO,
+                          {spr.position.x, spr.position.y, spr.position.z},
+                          {spr.dimensions.x, spr.dimensions.y, spr.dimensions.z},
+                          {spr.offsetTex.s, spr.offsetTex.t},
+                          spr.animFPS,
+                          spr.animStart,
+                          spr.animFrames,
+                          spr.animFirstFrame,
+                          (uint8_t)(spr.opaque ? 1 : 0)};
+        put(draw);
+    }
+}
+
+void captureClose()
+{
+    std::lock_guard<std::mutex> lock(captureMutex);
+    if (!traceFile)
+        return;
+    capturing = false;
+    put((uint8_t)TRACE_END);
+    fclose(traceFile);
+    traceFile = nullptr;
+}
+
+template <typename T>
+static bool get(FILE *file, T &value)
+{
+    return fread(&value, sizeof(T), 1, file) == 1;
+}
+
+bool loadTrace(const char *path, CommandTrace &trace)
+{
+    FILE *file = fopen(path, "rb");
+    if (!file)
+    {
+        printf("Cannot open trace %s\n", path);
+        return false;
+    }
+
+    TraceFileHeader header;
+    if (!get(file, header) || memcmp(header.magic, TRACE_MAGIC, sizeof(header.magic)) != 0 || header.version != TRACE_VERSION)
+    {
+        printf("%s is not a version %u command trace\n", path, TRACE_VERSION);
+        fclose(file);
+        return false;
+    }
+    trace.viewWidth = header.viewWidth;
+    trace.viewHeight = header.viewHeight;
+
+    bool ok = true;
+    uint8_t op = TRACE_END;
+    while (ok && get(file, op) && op != TRACE_END)
+    {
+        if (op == TRACE_TEXTURE)
+        {
+            TraceTexture tex;
+            int32_t width = 0, height = 0;
+            uint16_t length = 0;
+            ok = get(file, tex.id) && get(file, width) && get(file, height) && get(file, length);
+            tex.width = width;
+            tex.height = height;
+            tex.path.resize(length);
+            ok = ok && fread(&tex.path[0], 1, length, file) == length;
+            trace.textures.push_back(tex);
+        }
+        else if (op == TRACE_GEOMETRY)
+        {
+            TraceGeometry geometry;
+            uint32_t count = 0;
+            ok = get(file, geometry.vao) && get(file, count);
+            geometry.vertices.resize(count);
+            ok = ok && fread(geometry.vertices.data(), sizeof(float), count, file) == count;
+            trace.geometries.push_back(geometry);
+        }
+        else if (op == TRACE_STATE)
+        {
+            uint8_t blend = 0;
+            uint32_t src = 0, dst = 0, depth = 0;
+            ok = get(file, blend) && get(file, src) && get(file, dst) && get(file, depth);
+            trace.state.blend = blend != 0;
+            trace.state.blendSrc = src;
+            trace.state.blendDst = dst;
+            trace.state.depthFunc = depth;
+        }
+        else if (op == TRACE_FRAME)
+        {
+            uint32_t frameIndex = 0, count = 0;
+            float time = 0.0f;
+            double scroll = 0.0;
+            ok = get(file, frameIndex) && get(file, time) && get(file, scroll) && get(file, count);
+            trace.frames.emplace_back();
+            FrameSnapshot &frame = trace.frames.back();
+            frame.reset(frameIndex);
+            frame.time = time;
+            frame.backgroundScroll = scroll;
+            for (uint32_t i = 0; ok && i < count; i++)
+            {
+                TraceDraw draw;
+                ok = get(file, draw);
+                SpriteDraw spr;
+                spr.texID = draw.texID;
+                spr.VAO = draw.VAO;
+                spr.position = glm::vec3(draw.position[0], draw.position[1], draw.position[2]);
+                spr.dimensions = glm::vec3(draw.dimensions[0], draw.dimensions[1], draw.dimensions[2]);
+                spr.offsetTex = glm::vec2(draw.offsetTex[0], draw.offsetTex[1]);
+                spr.animFPS = draw.animFPS;
+                spr.animStart = draw.animStart;
+                spr.animFrames = draw.animFrames;
+                spr.animFirstFrame = draw.animFirstFrame;
+                spr.opaque = draw.opaque != 0;
+                frame.sprites.push_back(spr);
+            }
+        }
+        else
+            ok = false;
+    }
+    fclose(file);
+
+    // Um trace cortado (ex.: o jogo caiu) ainda é útil até o último frame completo
+    if (!ok && op == TRACE_FRAME && !trace.frames.empty())
+        trace.frames.pop_back();
+    if (!ok)
+        printf("Trace %s is truncated; replaying %zu complete frames\n", path, trace.frames.size());
+    return !trace.frames.empty();
+}
@@ -0,0 +1,89 @@
+#pragma once
+
+#include "RenderSnapshot.h"
+
+#include <string>
+#include <vector>
+
+// Captura do fluxo de comandos de desenho para replay offline (tools/replay.cpp).
+//
+// Formato do arquivo: TraceFileHeader seguido de registros que começam com um TraceOp:
+//   TRACE_TEXTURE  u32 id, i32 largura, i32 altura, u16 tamanho do caminho, caminho
+//   TRACE_GEOMETRY u32 vao, u32 nº de floats, floats (x y z s t por vértice, triangle strip)
+//   TRACE_STATE    u8 blend, u32 blendSrc, u32 blendDst, u32 depthFunc
+//   TRACE_FRAME    u32 frame, f32 tempo, f64 rolagem do fundo, u32 nº de desenhos, TraceDraw[nº de desenhos]
+//   TRACE_END
+// Os ids são os da sessão gravada; o replayer cria os seus e faz o mapeamento.
+
+enum TraceOp : uint8_t
+{
+    TRACE_END = 0,
+    TRACE_TEXTURE = 1,
+    TRACE_GEOMETRY = 2,
+    TRACE_STATE = 3,
+    TRACE_FRAME = 4
+};
+
+#pragma pack(push, 1)
+struct TraceFileHeader
+{
+    char magic[8]; // "SPRTRACE"
+    uint32_t version;
+    float viewWidth, viewHeight;
+};
+
+struct TraceDraw
+{
+    uint32_t texID;
+    uint32_t VAO;
+    float position[3];
+    float dimensions[3];
+    float offsetTex[2];
+    float animFPS, animStart;
+    uint16_t animFrames, animFirstFrame;
+    uint8_t opaque;
+};
+#pragma pack(pop)
+
+const uint32_t TRACE_VERSION = 4;
+
+// Gravação (só ativa depois de captureOpen)
+bool captureOpen(const char *path, float viewWidth, float viewHeight);
+bool captureActive();
+void captureTexture(GLuint id, int width, int height, const std::string &path);
+void captureGeometry(GLuint vao, const float *vertices, int floatCount);
+void captureState(bool blend, GLenum blendSrc, GLenum blendDst, GLenum depthFunc);
+void captureFrame(const FrameSnapshot &frame);
+void captureClose();
+
+// Leitura
+struct TraceTexture
+{
+    uint32_t id;
+    int width, height;
+    std::string path;
+};
+
+struct TraceGeometry
+{
+    uint32_t vao;
+    std::vector<float> vertices;
+};
+
+struct TraceState
+{
+    bool blend = true;
+    GLenum blendSrc = GL_SRC_ALPHA, blendDst = GL_ONE_MINUS_SRC_ALPHA;
+    GLenum depthFunc = GL_ALWAYS;
+};
+
+struct CommandTrace
+{
+    float viewWidth = 0.0f, viewHeight = 0.0f;
+    std::vector<TraceTexture> textures;
+    std::vector<TraceGeometry> geometries;
+    TraceState state;
+    std::vector<FrameSnapshot> frames;
+};
+
+bool loadTrace(const char *path, CommandTrace &trace);
@@ -0,0 +1,215 @@
+#include "DebugDraw.h"
+#include "Profiler.h"
+#include "SpriteShader.h"
+
+#include <cctype>
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <mutex>
+#include <string>
+
+#if DEBUG_DRAW_ENABLED
+std::atomic<uint32_t> debugDrawFlags{0};
+
+// Tarefas do grafo podem desenhar ao mesmo tempo; só há disputa com a camada ligada
+static std::mutex targetMutex;
+static std::vector<DebugVertex> *target = nullptr;
+
+const float DEBUG_LINE_WIDTH = 1.5f;
+const float DEBUG_TEXT_PIXEL = 2.0f; // lado, na tela, de cada pixel da fonte 3x5
+
+bool parseDebugDrawFlags(const char *spec, uint32_t &flags)
+{
+    flags = 0;
+    std::string list = spec;
+    size_t start = 0;
+    while (start <= list.size())
+    {
+        size_t comma = list.find(',', start);
+        std::string name = list.substr(start, comma == std::string::npos ? std::string::npos : comma - start);
+        if (name == "aabb")
+            flags |= DEBUG_DRAW_AABBS;
+        else if (name == "pairs")
+            flags |= DEBUG_DRAW_PAIRS;
+        else if (name == "cells")
+            flags |= DEBUG_DRAW_CELLS;
+        else if (name == "all")
+            flags |= DEBUG_DRAW_AABBS | DEBUG_DRAW_PAIRS | DEBUG_DRAW_CELLS;
+        else
+            return false;
+        if (comma == std::string::npos)
+            break;
+        start = comma + 1;
+    }
+    return true;
+}
+
+void debugDrawTarget(std::vector<DebugVertex> *vertices)
+{
+    std::lock_guard<std::mutex> lock(targetMutex);
+    target = vertices;
+}
+
+// Dois triângulos com os cantos a, b, c, d em sequência (a lista precisa estar travada)
+static void pushQuad(glm::vec2 a, glm::vec2 b, glm::vec2 c, glm::vec2 d, DebugColor color)
+{
+    const glm::vec2 corners[6] = {a, b, c, a, c, d};
+    for (const glm::vec2 &corner : corners)
+    {
+        DebugVertex vertex;
+        vertex.position[0] = corner.x;
+        vertex.position[1] = corner.y;
+        vertex.color[0] = color.r;
+        vertex.color[1] = color.g;
+        vertex.color[2] = color.b;
+        vertex.color[3] = color.a;
+        target->push_back(vertex);
+    }
+}
+
+static void pushLine(glm::vec2 from, glm::vec2 to, DebugColor color)
+{
+    glm::vec2 along = to - from;
+    float length = glm::length(along);
+    if (length <= 0.0f)
+        return;
+    // Linhas do perfil core têm 1 pixel: a espessura vem de um retângulo fino
+    glm::vec2 side = glm::vec2(-along.y, along.x) * (DEBUG_LINE_WIDTH * 0.5f / length);
+    pushQuad(from - side, to - side, to + side, from + side, color);
+}
+
+void debugLine(glm::vec2 from, glm::vec2 to, DebugColor color)
+{
+    std::lock_guard<std::mutex> lock(targetMutex);
+    if (target)
+        pushLine(from, to, color);
+}
+
+void debugRect(glm::vec2 min, glm::vec2 max, DebugColor color)
+{
+    std::lock_guard<std::mutex> lock(targetMutex);
+    if (!target)
+        return;
+    pushLine(glm::vec2(min.x, min.y), glm::vec2(max.x, min.y), color);
+    pushLine(glm::vec2(max.x, min.y), glm::vec2(max.x, max.y), color);
+    pushLine(glm::vec2(max.x, max.y), glm::vec2(min.x, max.y), color);
+    pushLine(glm::vec2(min.x, max.y), glm::vec2(min.x, min.y), color);
+}
+
+void debugFilledRect(glm::vec2 min, glm::vec2 max, DebugColor color)
+{
+    std::lock_guard<std::mutex> lock(targetMutex);
+    if (target)
+        pushQuad(min, glm::vec2(max.x, min.y), max, glm::vec2(min.x, max.y), color);
+}
+
+// Fonte 3x5: cinco linhas de três bits, de cima para baixo, com o bit mais alto à esquerda
+static uint16_t glyph(char c)
+{
+    static const uint16_t digits[10] = {
+        0b111'101'101'101'111, 0b010'110'010'010'111, 0b111'001'111'100'111, 0b111'001'111'001'111,
+        0b101'101'111'001'001, 0b111'100'111'001'111, 0b111'100'111'101'111, 0b111'001'001'001'001,
+        0b111'101'111'101'111, 0b111'101'111'001'111,
+    };
+    static const uint16_t letters[26] = {
+        0b010'101'111'101'101, 0b110'101'110'101'110, 0b011'100'100'100'011, 0b110'101'101'101'110, // A B C D
+        0b111'100'110'100'111, 0b111'100'110'100'100, 0b011'100'101'101'011, 0b101'101'111'101'101, // E F G H
+        0b111'010'010'010'111, 0b001'001'001'101'010, 0b101'101'110'101'101, 0b100'100'100'100'111, // I J K L
+        0b101'111'111'101'101, 0b110'101'101'101'101, 0b010'101'101'101'010, 0b110'101'110'100'100, // M N O P
+        0b010'101'101'110'011, 0b110'101'110'101'101, 0b011'100'010'001'110, 0b111'010'010'010'010, // Q R S T
+        0b101'101'101'101'111, 0b101'101'101'101'010, 0b101'101'111'111'101, 0b101'101'010'101'101, // U V W X
+        0b101'101'010'010'010, 0b111'001'010'100'111,                                               // Y Z
+    };
+    if (c >= '0' && c <= '9')
+        return digits[c - '0'];
+    if (std::isalpha((unsigned char)c))
+        return letters[std::toupper((unsigned char)c) - 'A'];
+    if (c == '-')
+        return 0b000'000'111'000'000;
+    if (c == '.')
+        return 0b000'000'000'000'010;
+    if (c == ':')
+        return 0b000'010'000'010'000;
+    return 0;
+}
+
+void debugText(glm::vec2 at, DebugColor color, const char *text)
+{
+    std::lock_guard<std::mutex> lock(targetMutex);
+    if (!target)
+        return;
+    const float pixel = DEBUG_TEXT_PIXEL;
+    for (; *text; text++, at.x += 4.0f * pixel)
+    {
+        uint16_t bits = glyph(*text);
+        for (int row = 0; row < 5; row++)
+            for (int col = 0; col < 3; col++)
+                if (bits & (1 << (14 - row * 3 - col)))
+                {
+                    glm::vec2 min = at + glm::vec2(col * pixel, (4 - row) * pixel);
+                    pushQuad(min, min + glm::vec2(pixel, 0.0f), min + glm::vec2(pixel), min + glm::vec2(0.0f, pixel), color);
+                }
+    }
+}
+
+bool DebugDrawRenderer::setup(float viewWidth, float viewHeight, bool allowPersistentMapping)
+{
+    std::string vertexSource, fragmentSource, errorLog;
+    if (!readShaderSource(DEBUG_VERTEX_SHADER_PATH, vertexSource) || !readShaderSource(DEBUG_FRAGMENT_SHADER_PATH, fragmentSource))
+    {
+        printf("Debug draw disabled: cannot read %s or %s\n", DEBUG_VERTEX_SHADER_PATH, DEBUG_FRAGMENT_SHADER_PATH);
+        return false;
+    }
+    program = compileShaderProgram(vertexSource, fragmentSource, errorLog);
+    if (!program)
+    {
+        printf("Debug draw disabled: shader failed\n%s\n", errorLog.c_str());
+        return false;
+    }
+    glUseProgram(program);
+    glUniform2f(glGetUniformLocation(program, "viewSize"), viewWidth, viewHeight);
+
+    vertexStream.create(GL_ARRAY_BUFFER, 4096 * sizeof(DebugVertex), allowPersistentMapping, "debug draw");
+    glGenVertexArrays(1, &VAO);
+    glBindVertexArray(VAO);
+    glEnableVertexAttribArray(0);
+    glEnableVertexAttribArray(1);
+    glBindVertexArray(0);
+    return true;
+}
+
+void DebugDrawRenderer::destroy()
+{
+    if (program)
+    {
+        vertexStream.destroy();
+        glDeleteProgram(program);
+    }
+    if (VAO)
+        glDeleteVertexArrays(1, &VAO);
+    program = VAO = 0;
+}
+
+void DebugDrawRenderer::draw(const std::vector<DebugVertex> &vertices)
+{
+    if (vertices.empty())
+        return;
+    PROFILE_ZONE("drawDebug");
+    size_t bytes = vertices.size() * sizeof(DebugVertex);
+    memcpy(vertexStream.map(bytes), vertices.data(), bytes);
+    vertexStream.commit(bytes);
+
+    glUseProgram(program);
+    glBindVertexArray(VAO);
+    size_t base = vertexStream.offset();
+    const GLsizei stride = sizeof(DebugVertex);
+    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, stride, (GLvoid *)(base + offsetof(DebugVertex, position)));
+    glVertexAttribPointer(1, 4, GL_UNSIGNED_BYTE, GL_TRUE, stride, (GLvoid *)(base + offsetof(DebugVertex, color)));
+    glDisable(GL_DEPTH_TEST);
+    glDrawArrays(GL_TRIANGLES, 0, (GLsizei)vertices.size());
+    glEnable(GL_DEPTH_TEST);
+    vertexStream.fence();
+}
+
+#endif
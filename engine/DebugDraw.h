@@ -0,0 +1,83 @@
+#pragma once
+
+#include "RenderSnapshot.h"
+#include "StreamBuffer.h"
+
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+// Camada de desenho de depuração em modo imediato: linhas, retângulos e marcadores de texto
+// chamados de qualquer ponto da simulação viram triângulos na lista do snapshot em montagem, e o
+// Renderer desenha a lista inteira em um único glDrawArrays, por cima da cena e na resolução da
+// janela.
+//
+// Só existe nos builds de desenvolvimento: com NDEBUG (release) DEBUG_DRAW_ENABLED (definido em
+// RenderSnapshot.h) é 0 e a camada inteira fica de fora da compilação; sobram os bits de grupo e
+// debugDrawOn, sempre false. Em tempo de execução, cada grupo de desenhos é ligado por um bit de
+// debugDrawFlags; desligado, custa uma leitura atômica.
+
+enum DebugDrawFlag : uint32_t
+{
+    DEBUG_DRAW_AABBS = 1 << 0, // caixas de colisão (pMin / pMax) das sprites
+    DEBUG_DRAW_PAIRS = 1 << 1, // pares nave-meteoro próximos e colisões
+    DEBUG_DRAW_CELLS = 1 << 2, // células ocupadas da grade de descarte
+};
+
+#if DEBUG_DRAW_ENABLED
+extern std::atomic<uint32_t> debugDrawFlags;
+#endif
+
+inline bool debugDrawOn(uint32_t flag)
+{
+#if DEBUG_DRAW_ENABLED
+    return debugDrawFlags.load(std::memory_order_relaxed) & flag;
+#else
+    (void)flag;
+    return false;
+#endif
+}
+
+#if DEBUG_DRAW_ENABLED
+// "aabb,pairs,cells" ou "all"; false se algum nome for desconhecido
+bool parseDebugDrawFlags(const char *spec, uint32_t &flags);
+
+// RGBA sem pré-multiplicar, 0 a 255
+struct DebugColor
+{
+    uint8_t r, g, b, a;
+};
+
+// Lista que recebe os desenhos seguintes (a do snapshot do frame; nullptr descarta)
+void debugDrawTarget(std::vector<DebugVertex> *vertices);
+// Coordenadas em pixels do mundo, com a origem no canto inferior esquerdo
+void debugLine(glm::vec2 from, glm::vec2 to, DebugColor color);
+void debugRect(glm::vec2 min, glm::vec2 max, DebugColor color);
+void debugFilledRect(glm::vec2 min, glm::vec2 max, DebugColor color);
+// Texto em fonte 3x5 (dígitos, letras sem acento, "-", "." e ":"), canto inferior esquerdo em at
+void debugText(glm::vec2 at, DebugColor color, const char *text);
+
+const char *const DEBUG_VERTEX_SHADER_PATH = "shaders/debug.vert";
+const char *const DEBUG_FRAGMENT_SHADER_PATH = "shaders/debug.frag";
+
+// Envio e desenho da lista de depuração. Só deve ser usado na thread dona do contexto.
+class DebugDrawRenderer
+{
+public:
+    // false (e nada é desenhado) se o shader faltar ou não compilar
+    bool setup(float viewWidth, float viewHeight, bool allowPersistentMapping);
+    void destroy();
+    bool ready() const { return program != 0; }
+
+    // Sem teste de profundidade, com o blending corrente; deixa o próprio programa em uso
+    void draw(const std::vector<DebugVertex> &vertices);
+
+private:
+    GLuint program = 0;
+    GLuint VAO = 0;
+    StreamBuffer vertexStream;
+};
+#endif
@@ -0,0 +1,170 @@
+#include "DynamicResolution.h"
+#include "ResourceRegistry.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+
+// Folga do orçamento: a ampliação, o swap e a variação entre frames também cabem no frame
+const double BUDGET_HEADROOM = 0.85;
+// Abaixo desta fração do orçamento a escala sobe devagar; acima dele desce na hora
+const double RAISE_THRESHOLD = 0.7;
+const float RAISE_STEP = 0.05f;
+// Um frame acima deste múltiplo do orçamento derruba a escala sem esperar a média
+const double SPIKE_FACTOR = 1.5;
+
+void DynamicResolution::setup(const DynamicResolutionConfig &config, int windowWidth, int windowHeight)
+{
+    if (!config.enabled)
+        return;
+    this->config = config;
+    this->windowWidth = windowWidth;
+    this->windowHeight = windowHeight;
+    budgetMs = 1000.0 / config.targetFps * BUDGET_HEADROOM;
+    currentScale = lowestScale = config.maxScale;
+
+    glGenTextures(1, &colorBuffer);
+    glBindTexture(GL_TEXTURE_2D, colorBuffer);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, windowWidth, windowHeight, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+    glBindTexture(GL_TEXTURE_2D, 0);
+    trackTexture(colorBuffer, windowWidth, windowHeight, GL_RGBA8, 1, "dynamic resolution color");
+
+    // Profundidade para as passadas opaca/translúcida e stencil para a contagem de overdraw
+    glGenRenderbuffers(1, &depthStencilBuffer);
+    glBindRenderbuffer(GL_RENDERBUFFER, depthStencilBuffer);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH24_STENCIL8, windowWidth, windowHeight);
+    glBindRenderbuffer(GL_RENDERBUFFER, 0);
+
+    glGenFramebuffers(1, &fbo);
+    glBindFramebuffer(GL_FRAMEBUFFER, fbo);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, colorBuffer, 0);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT, GL_RENDERBUFFER, depthStencilBuffer);
+    GLenum status = glCheckFramebufferStatus(GL_FRAMEBUFFER);
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    if (status != GL_FRAMEBUFFER_COMPLETE)
+    {
+        printf("Dynamic resolution disabled: framebuffer incomplete (0x%x)\n", status);
+        destroy();
+        return;
+    }
+
+    glGenQueries(QUERY_COUNT, queries);
+    printf("Dynamic resolution: %dx%d at %.0f%%-%.0f%%, GPU budget %.2f ms\n", windowWidth, windowHeight, config.minScale * 100.0f,
+           config.maxScale * 100.0f, budgetMs);
+}
+
+void DynamicResolution::destroy()
+{
+    if (fbo)
+        glDeleteFramebuffers(1, &fbo);
+    if (depthStencilBuffer)
+        glDeleteRenderbuffers(1, &depthStencilBuffer);
+    if (colorBuffer)
+    {
+        glDeleteTextures(1, &colorBuffer);
+        untrack(ResourceKind::Texture, colorBuffer);
+    }
+    if (queries[0])
+        glDeleteQueries(QUERY_COUNT, queries);
+    fbo = depthStencilBuffer = colorBuffer = 0;
+    for (int i = 0; i < QUERY_COUNT; i++)
+    {
+        queries[i] = 0;
+        queryPending[i] = false;
+    }
+}
+
+void DynamicResolution::begin()
+{
+    collectTimings();
+
+    scaledWidth = std::max(1, (int)std::lround(windowWidth * currentScale));
+    scaledHeight = std::max(1, (int)std::lround(windowHeight * currentScale));
+    glBindFramebuffer(GL_FRAMEBUFFER, fbo);
+    glViewport(0, 0, scaledWidth, scaledHeight);
+    // O glClear ignora o viewport: o scissor evita limpar a parte do FBO fora da escala
+    glEnable(GL_SCISSOR_TEST);
+    glScissor(0, 0, scaledWidth, scaledHeight);
+
+    // Se a consulta da vez ainda não voltou, este frame fica sem medição
+    if (!queryPending[nextQuery])
+        glBeginQuery(GL_TIME_ELAPSED, queries[nextQuery]);
+}
+
+void DynamicResolution::end()
+{
+    glDisable(GL_SCISSOR_TEST);
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, fbo);
+    glBindFramebuffer(GL_DRAW_FRAMEBUFFER, 0);
+    glBlitFramebuffer(0, 0, scaledWidth, scaledHeight, 0, 0, windowWidth, windowHeight, GL_COLOR_BUFFER_BIT, GL_LINEAR);
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    glViewport(0, 0, windowWidth, windowHeight);
+
+    if (!queryPending[nextQuery])
+    {
+        glEndQuery(GL_TIME_ELAPSED);
+        queryPending[nextQuery] = true;
+        nextQuery = (nextQuery + 1) % QUERY_COUNT;
+    }
+
+    frames++;
+    scaleSum += currentScale;
+}
+
+// Lê, sem bloquear, as medições que a GPU já terminou
+void DynamicResolution::collectTimings()
+{
+    for (int i = 0; i < QUERY_COUNT; i++)
+    {
+        int index = (nextQuery + i) % QUERY_COUNT;
+        if (!queryPending[index])
+            continue;
+        GLint available = 0;
+        glGetQueryObjectiv(queries[index], GL_QUERY_RESULT_AVAILABLE, &available);
+        if (!available)
+            break;
+        GLuint64 elapsed = 0;
+        glGetQueryObjectui64v(queries[index], GL_QUERY_RESULT, &elapsed);
+        queryPending[index] = false;
+        adjust(elapsed / 1.0e6);
+    }
+}
+
+void DynamicResolution::adjust(double gpuMs)
+{
+    samples++;
+    smoothedMs = samples == 1 ? gpuMs : smoothedMs * 0.8 + gpuMs * 0.2;
+    samplesSinceAdjust++;
+
+    float scale = currentScale;
+    if (gpuMs > budgetMs * SPIKE_FACTOR || (samplesSinceAdjust >= ADJUST_INTERVAL && smoothedMs > budgetMs))
+    {
+        // Custo proporcional à área: a escala linear cai com a raiz da razão
+        double measured = std::max(gpuMs, smoothedMs);
+        scale = currentScale * (float)std::max(0.75, std::sqrt(budgetMs / measured));
+    }
+    else if (samplesSinceAdjust >= ADJUST_INTERVAL && smoothedMs < budgetMs * RAISE_THRESHOLD)
+        scale = currentScale + RAISE_STEP;
+    else
+        return;
+
+    scale = std::min(config.maxScale, std::max(config.minScale, scale));
+    samplesSinceAdjust = 0;
+    if (scale == currentScale)
+        return;
+    currentScale = scale;
+    // A média antiga foi medida em outra resolução
+    smoothedMs = budgetMs;
+    lowestScale = std::min(lowestScale, scale);
+    changes++;
+}
+
+void DynamicResolution::printSummary() const
+{
+    if (!enabled() || !frames)
+        return;
+    printf("Dynamic resolution: average scale %.0f%%, lowest %.0f%%, %llu changes, GPU %.2f ms smoothed (budget %.2f ms)\n",
+           scaleSum / frames * 100.0, lowestScale * 100.0f, (unsigned long long)changes, smoothedMs, budgetMs);
+}
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <glad/glad.h>
+
+#include <cstdint>
+
+// Resolução dinâmica: a cena é desenhada em um FBO em escala entre minScale e maxScale da
+// resolução da janela e ampliada com um único glBlitFramebuffer filtrado. A escala segue o tempo
+// de GPU medido (GL_TIME_ELAPSED, lido sem esperar), para manter o frame dentro do orçamento.
+struct DynamicResolutionConfig
+{
+    bool enabled = false;
+    double targetFps = 60.0;
+    float minScale = 0.5f;
+    float maxScale = 1.0f;
+};
+
+class DynamicResolution
+{
+public:
+    // Cria o FBO no tamanho máximo (o da janela); a escala só muda o viewport, sem realocar nada
+    void setup(const DynamicResolutionConfig &config, int windowWidth, int windowHeight);
+    void destroy();
+    bool enabled() const { return fbo != 0; }
+
+    // Liga o FBO com o viewport da escala atual e começa a medição do frame
+    void begin();
+    // Amplia o conteúdo para a janela e termina a medição
+    void end();
+
+    float scale() const { return currentScale; }
+    void printSummary() const;
+
+private:
+    static const int QUERY_COUNT = 4; // resultados chegam alguns frames depois
+    static const int ADJUST_INTERVAL = 8;
+
+    void collectTimings();
+    void adjust(double gpuMs);
+
+    DynamicResolutionConfig config;
+    int windowWidth = 0, windowHeight = 0;
+    int scaledWidth = 0, scaledHeight = 0;
+    GLuint fbo = 0, colorBuffer = 0, depthStencilBuffer = 0;
+
+    GLuint queries[QUERY_COUNT] = {};
+    bool queryPending[QUERY_COUNT] = {};
+    int nextQuery = 0;
+
+    // Controlador
+    float currentScale = 1.0f;
+    double budgetMs = 0.0;
+    double smoothedMs = 0.0;
+    int samplesSinceAdjust = 0;
+
+    // Estatísticas
+    uint64_t frames = 0, samples = 0, changes = 0;
+    double scaleSum = 0.0;
+    float lowestScale = 1.0f;
+};
@@ -0,0 +1,147 @@
+#include "FlightRecorder.h"
+
+#include <atomic>
+#include <chrono>
+#include <csignal>
+#include <cstdio>
+#include <cstring>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+static FlightEvent ring[FLIGHT_CAPACITY];
+static std::atomic<uint64_t> head{0};
+static uint32_t currentFrame = 0;
+static std::chrono::steady_clock::time_point origin = std::chrono::steady_clock::now();
+static char dumpPath[512] = "flight-recorder.bin";
+
+#ifndef _WIN32
+static void flightSignalHandler(int sig)
+{
+    flightDump(FLIGHT_DUMP_SIGNAL);
+    // SA_RESETHAND já restaurou o handler padrão: repete o sinal para o processo terminar normalmente
+    raise(sig);
+}
+#endif
+
+void flightRecorderStart(const char *path)
+{
+    if (path)
+    {
+        strncpy(dumpPath, path, sizeof(dumpPath) - 1);
+        dumpPath[sizeof(dumpPath) - 1] = '\0';
+    }
+    origin = std::chrono::steady_clock::now();
+
+#ifndef _WIN32
+    struct sigaction action;
+    memset(&action, 0, sizeof(action));
+    action.sa_handler = flightSignalHandler;
+    action.sa_flags = SA_RESETHAND;
+    sigemptyset(&action.sa_mask);
+    sigaction(SIGSEGV, &action, nullptr);
+    sigaction(SIGABRT, &action, nullptr);
+    sigaction(SIGBUS, &action, nullptr);
+    sigaction(SIGFPE, &action, nullptr);
+#endif
+}
+
+void flightSetFrame(uint32_t frame)
+{
+    currentFrame = frame;
+}
+
+void flightRecord(FlightEventType type, uint8_t arg8, uint32_t arg32, float x, float y)
+{
+    using namespace std::chrono;
+    uint64_t index = head.fetch_add(1, std::memory_order_relaxed);
+    FlightEvent &e = ring[index & (FLIGHT_CAPACITY - 1)];
+    e.frame = currentFrame;
+    e.timeMs = (uint32_t)duration_cast<milliseconds>(steady_clock::now() - origin).count();
+    e.type = type;
+    e.arg8 = arg8;
+    e.arg32 = arg32;
+    e.x = x;
+    e.y = y;
+}
+
+bool flightDump(FlightDumpReason reason)
+{
+    flightRecord(FLIGHT_DUMP, reason, 0, 0.0f, 0.0f);
+
+    uint64_t total = head.load(std::memory_order_relaxed);
+    uint32_t count = total < FLIGHT_CAPACITY ? (uint32_t)total : FLIGHT_CAPACITY;
+    uint32_t first = (uint32_t)((total - count) & (FLIGHT_CAPACITY - 1));
+
+    FlightFileHeader header;
+    memcpy(header.magic, FLIGHT_MAGIC, sizeof(header.magic));
+    header.version = FLIGHT_VERSION;
+    header.eventSize = sizeof(FlightEvent);
+    header.capacity = FLIGHT_CAPACITY;
+    header.count = count;
+    header.totalRecorded = total;
+
+    // Do mais antigo ao fim do vetor, depois do início até o mais novo
+    uint32_t tail = FLIGHT_CAPACITY - first < count ? FLIGHT_CAPACITY - first : count;
+    const void *parts[3] = {&header, &ring[first], &ring[0]};
+    size_t sizes[3] = {sizeof(header), tail * sizeof(FlightEvent), (count - tail) * sizeof(FlightEvent)};
+
+#ifndef _WIN32
+    // Apenas chamadas async-signal-safe: pode ser chamado de um handler de sinal
+    int fd = open(dumpPath, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0)
+        return false;
+    bool ok = true;
+    for (int i = 0; i < 3; i++)
+    {
+        const char *data = (const char *)parts[i];
+        size_t left = sizes[i];
+        while (ok && left > 0)
+        {
+            ssize_t written = write(fd, data, left);
+            if (written <= 0)
+                ok = false;
+            else
+            {
+                data += written;
+                left -= written;
+            }
+        }
+    }
+    close(fd);
+    return ok;
+#else
+    FILE *file = fopen(dumpPath, "wb");
+    if (!file)
+        return false;
+    bool ok = true;
+    for (int i = 0; i < 3; i++)
+        if (sizes[i] && fwrite(parts[i], 1, sizes[i], file) != sizes[i])
+            ok = false;
+    fclose(file);
+    return ok;
+#endif
+}
+
+const char *flightEventName(uint8_t type)
+{
+    switch (type)
+    {
+    case FLIGHT_FRAME:
+        return "frame";
+    case FLIGHT_STATE:
+        return "state";
+    case FLIGHT_COLLISION:
+        return "collision";
+    case FLIGHT_RESPAWN:
+        return "respawn";
+    case FLIGHT_INPUT:
+        return "input";
+    case FLIGHT_DUMP:
+        return "dump";
+    default:
+        return "unknown";
+    }
+}
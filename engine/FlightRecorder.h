@@ -0,0 +1,60 @@
+#pragma once
+
+#include <cstdint>
+
+// Gravador de voo: buffer circular de tamanho fixo com os últimos eventos do jogo
+// (tempos de frame, mudanças de estado, colisões, respawns, teclas). É despejado em
+// um arquivo binário na saída, em SIGSEGV/SIGABRT ou pela tecla F2.
+// Formato do arquivo: FlightFileHeader seguido de `count` FlightEvent, do mais antigo ao mais novo.
+
+enum FlightEventType : uint8_t
+{
+    FLIGHT_FRAME = 1,     // x = duração do frame (ms), y = duração da simulação+desenho (ms)
+    FLIGHT_STATE = 2,     // arg8 = estado anterior, arg32 = novo estado
+    FLIGHT_COLLISION = 3, // arg32 = índice do meteoro, x/y = posição da nave
+    FLIGHT_RESPAWN = 4,   // arg32 = índice do meteoro, x/y = nova posição
+    FLIGHT_INPUT = 5,     // arg32 = tecla GLFW, arg8 = ação (0 solta, 1 pressiona)
+    FLIGHT_DUMP = 6       // arg8 = motivo do despejo (FlightDumpReason)
+};
+
+enum FlightDumpReason : uint8_t
+{
+    FLIGHT_DUMP_EXIT = 0,
+    FLIGHT_DUMP_HOTKEY = 1,
+    FLIGHT_DUMP_SIGNAL = 2
+};
+
+#pragma pack(push, 1)
+struct FlightEvent
+{
+    uint32_t frame;
+    uint32_t timeMs; // desde o início da gravação
+    uint8_t type;
+    uint8_t arg8;
+    uint32_t arg32; // 32 bits: o índice do meteoro passa de 65535 nas varreduras grandes
+    float x, y;
+};
+
+struct FlightFileHeader
+{
+    char magic[8]; // "FLIGHTR\0"
+    uint32_t version;
+    uint32_t eventSize;
+    uint32_t capacity;
+    uint32_t count;
+    uint64_t totalRecorded; // eventos gravados desde o início (inclui os sobrescritos)
+};
+#pragma pack(pop)
+
+const char FLIGHT_MAGIC[8] = {'F', 'L', 'I', 'G', 'H', 'T', 'R', '\0'};
+const uint32_t FLIGHT_VERSION = 2; // 2: arg32 no lugar do arg16 (índices de meteoro acima de 65535)
+const uint32_t FLIGHT_CAPACITY = 1 << 14; // potência de 2
+
+// Abre a gravação e instala os handlers de sinal; path é copiado
+void flightRecorderStart(const char *path);
+void flightSetFrame(uint32_t frame);
+void flightRecord(FlightEventType type, uint8_t arg8, uint32_t arg32, float x, float y);
+// Escreve o buffer no arquivo (seguro dentro de um handler de sinal)
+bool flightDump(FlightDumpReason reason);
+
+const char *flightEventName(uint8_t type);
@@ -0,0 +1,90 @@
+#include "FramePacer.h"
+#include "Benchmark.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <thread>
+
+void FramePacer::setup(const FramePacingConfig &config, double refreshHz)
+{
+    this->config = config;
+    if (config.mode == PacingMode::Capped && config.targetFps > 0.0)
+        period = 1.0 / config.targetFps;
+    else if (config.mode == PacingMode::VSync && refreshHz > 0.0)
+        period = 1.0 / refreshHz;
+    else
+        period = 0.0;
+
+    lastFrameEnd = monotonicSeconds();
+    nextDeadline = lastFrameEnd + period;
+    frameCount = missed = 0;
+    intervalSum = intervalSqSum = 0.0;
+}
+
+void FramePacer::waitUntil(double deadline)
+{
+    double now = monotonicSeconds();
+    double sleepFor = deadline - now - spinMargin;
+    if (sleepFor > 0.0)
+    {
+        std::this_thread::sleep_for(std::chrono::duration<double>(sleepFor));
+
+        // Se o sleep passou do ponto, aumenta a margem de espera ativa (e a reduz devagar)
+        double overshoot = monotonicSeconds() - (now + sleepFor);
+        spinMargin = std::max(spinMargin * 0.95, std::min(overshoot * 1.25, 0.004));
+    }
+    while (monotonicSeconds() < deadline)
+        std::this_thread::yield();
+}
+
+void FramePacer::endFrame()
+{
+    if (config.mode == PacingMode::Capped && period > 0.0)
+    {
+        if (monotonicSeconds() > nextDeadline)
+        {
+            // Prazo perdido: recomeça a grade a partir de agora em vez de tentar recuperar com frames seguidos
+            missed++;
+            nextDeadline = monotonicSeconds();
+        }
+        else
+            waitUntil(nextDeadline);
+        nextDeadline += period;
+    }
+
+    double now = monotonicSeconds();
+    lastInterval = now - lastFrameEnd;
+    lastFrameEnd = now;
+
+    // Com vsync o swap já bloqueia; um intervalo acima de 1.5 período significa um refresh perdido
+    if (config.mode == PacingMode::VSync && period > 0.0 && lastInterval > period * 1.5)
+        missed++;
+
+    frameCount++;
+    intervalSum += lastInterval;
+    intervalSqSum += lastInterval * lastInterval;
+}
+
+void FramePacer::resync()
+{
+    lastFrameEnd = monotonicSeconds();
+    nextDeadline = lastFrameEnd + period;
+}
+
+void FramePacer::printSummary() const
+{
+    if (frameCount == 0)
+        return;
+
+    const char *names[] = {"vsync", "capped", "uncapped"};
+    double mean = intervalSum / frameCount;
+    double jitter = std::sqrt(std::max(0.0, intervalSqSum / frameCount - mean * mean));
+    printf("Frame pacing (%s", names[(int)config.mode]);
+    if (config.mode == PacingMode::Capped)
+        printf(" %.0f fps", config.targetFps);
+    printf("): %llu frames, %llu missed deadlines (%.2f%%), interval %.3f ms +- %.3f ms\n",
+           (unsigned long long)frameCount, (unsigned long long)missed, 100.0 * missed / frameCount, mean * 1000.0,
+           jitter * 1000.0);
+}
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <cstdint>
+
+// Ritmo dos frames: vsync, limite de FPS (sleep + espera ativa no relógio monotônico) ou sem limite
+enum class PacingMode
+{
+    VSync,
+    Capped,
+    Uncapped
+};
+
+struct FramePacingConfig
+{
+    PacingMode mode = PacingMode::VSync;
+    double targetFps = 60.0; // usado no modo Capped
+};
+
+class FramePacer
+{
+public:
+    // refreshHz: taxa do monitor, usada para detectar frames perdidos no modo vsync
+    void setup(const FramePacingConfig &config, double refreshHz);
+
+    // Intervalo para glfwSwapInterval
+    int swapInterval() const { return config.mode == PacingMode::VSync ? 1 : 0; }
+
+    // Chamado uma vez por frame, depois do swap: espera até o próximo prazo (modo Capped)
+    // e contabiliza prazos perdidos
+    void endFrame();
+    // Depois de um período ocioso sem frames: recomeça os prazos sem contar perdas
+    void resync();
+
+    uint64_t frames() const { return frameCount; }
+    uint64_t missedDeadlines() const { return missed; }
+    double lastIntervalMs() const { return lastInterval * 1000.0; }
+    void printSummary() const;
+
+private:
+    void waitUntil(double deadline);
+
+    FramePacingConfig config;
+    double period = 0.0;      // segundos por frame (0 = sem prazo)
+    double nextDeadline = 0.0;
+    double lastFrameEnd = 0.0;
+    double lastInterval = 0.0;
+    double spinMargin = 0.001; // parte final da espera feita em espera ativa; ajustada pelo atraso do sleep
+    uint64_t frameCount = 0;
+    uint64_t missed = 0;
+    double intervalSum = 0.0;
+    double intervalSqSum = 0.0;
+};
@@ -0,0 +1,40 @@
+#include "GameClock.h"
+
+GameClock gameClock;
+
+void GameClock::start()
+{
+    origin = std::chrono::steady_clock::now();
+    frameTicks = wallTicks = 0;
+}
+
+void GameClock::setFixedStep(int tickRate)
+{
+    fixedRate = tickRate;
+    fixedBase = frameTicks;
+    fixedCount = 0;
+}
+
+uint64_t GameClock::tick()
+{
+    if (fixedRate > 0)
+    {
+        fixedCount++;
+        frameTicks = fixedBase + fixedCount * TICKS_PER_SECOND / fixedRate;
+    }
+    else
+        frameTicks = sampleWall();
+    return frameTicks;
+}
+
+uint64_t GameClock::sampleWall()
+{
+    wallTicks = read();
+    return wallTicks;
+}
+
+uint64_t GameClock::read() const
+{
+    using namespace std::chrono;
+    return (uint64_t)duration_cast<microseconds>(steady_clock::now() - origin).count();
+}
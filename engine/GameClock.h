@@ -0,0 +1,44 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+
+// Relógio do jogo em ticks inteiros (microssegundos desde start), amostrado uma vez por tick da
+// simulação. Com inteiros de 64 bits a resolução não se degrada com o tempo de execução, ao
+// contrário de guardar segundos da glfwGetTime em float.
+//
+// Em tempo real (padrão) o tempo da simulação é o relógio real. Com passo fixo (escala de tempo,
+// ver TimeScale.h) cada tick avança exatamente 1/tickRate segundo simulado, sem olhar o relógio.
+class GameClock
+{
+public:
+    static const uint64_t TICKS_PER_SECOND = 1000000;
+
+    // Zera o relógio
+    void start();
+    // Passa a avançar um passo fixo por tick (0 volta ao tempo real)
+    void setFixedStep(int tickRate);
+    // Início de um tick da simulação: fixa o tempo que toda a simulação do tick enxerga
+    uint64_t tick();
+    // Amostra só o relógio real (no passo fixo, uma vez por frame, antes de consumir a entrada)
+    uint64_t sampleWall();
+    // Tempo da simulação no tick atual
+    uint64_t now() const { return frameTicks; }
+    // Relógio real na última amostragem (tick em tempo real ou sampleWall)
+    uint64_t wallNow() const { return wallTicks; }
+    // Leitura imediata do relógio real, sem mudar o tempo do frame (ex.: cálculo de espera ociosa)
+    uint64_t read() const;
+
+    static uint64_t fromSeconds(double seconds) { return (uint64_t)(seconds * TICKS_PER_SECOND + 0.5); }
+    static double toSeconds(int64_t ticks) { return (double)ticks / TICKS_PER_SECOND; }
+
+private:
+    std::chrono::steady_clock::time_point origin = std::chrono::steady_clock::now();
+    uint64_t frameTicks = 0;
+    uint64_t wallTicks = 0;
+    // Passo fixo: tempo = fixedBase + fixedCount / fixedRate segundos (exato, sem acumular arredondamento)
+    int fixedRate = 0;
+    uint64_t fixedBase = 0, fixedCount = 0;
+};
+
+extern GameClock gameClock;
@@ -0,0 +1,191 @@
+#include "GpuCulling.h"
+#include "Profiler.h"
+#include "ResourceRegistry.h"
+#include "SpriteShader.h"
+
+#include <GLFW/glfw3.h>
+
+#include <cstdio>
+#include <cstring>
+#include <string>
+
+// Enums e funções do GL 4.3 que o loader 3.3 do projeto não traz
+#ifndef GL_SHADER_STORAGE_BUFFER
+#define GL_SHADER_STORAGE_BUFFER 0x90D2
+#endif
+#ifndef GL_DRAW_INDIRECT_BUFFER
+#define GL_DRAW_INDIRECT_BUFFER 0x8F3F
+#endif
+#ifndef GL_VERTEX_ATTRIB_ARRAY_BARRIER_BIT
+#define GL_VERTEX_ATTRIB_ARRAY_BARRIER_BIT 0x00000001
+#define GL_COMMAND_BARRIER_BIT 0x00000040
+#define GL_SHADER_STORAGE_BARRIER_BIT 0x00002000
+#endif
+typedef void(APIENTRYP DispatchComputeProc)(GLuint groupsX, GLuint groupsY, GLuint groupsZ);
+typedef void(APIENTRYP MemoryBarrierProc)(GLbitfield barriers);
+typedef void(APIENTRYP DrawArraysIndirectProc)(GLenum mode, const void *indirect);
+static DispatchComputeProc dispatchCompute = nullptr;
+static MemoryBarrierProc memoryBarrier = nullptr;
+static DrawArraysIndirectProc drawArraysIndirect = nullptr;
+
+const GLuint CULL_GROUP_SIZE = 64; // GROUP_SIZE (local_size_x) do shader
+
+// Comando inicial: o nº de vértices vem da sprite protótipo e o de instâncias do compute shader
+const GLuint INITIAL_COMMAND[4] = {4, 0, 0, 0};
+
+// Bytes de uma instância de sprite (12 floats, o SpriteInstance do Renderer)
+const size_t CULLED_INSTANCE_BYTES = 12 * sizeof(float);
+
+bool GpuCuller::setup(float viewWidth, float viewHeight, bool allowPersistentMapping)
+{
+    attempted = true;
+    this->viewWidth = viewWidth;
+    this->viewHeight = viewHeight;
+    if (GLVersion.major < 4 || (GLVersion.major == 4 && GLVersion.minor < 3))
+        return false;
+    dispatchCompute = (DispatchComputeProc)glfwGetProcAddress("glDispatchCompute");
+    memoryBarrier = (MemoryBarrierProc)glfwGetProcAddress("glMemoryBarrier");
+    drawArraysIndirect = (DrawArraysIndirectProc)glfwGetProcAddress("glDrawArraysIndirect");
+    if (!dispatchCompute || !memoryBarrier || !drawArraysIndirect)
+        return false;
+
+    std::string source, errorLog;
+    if (!readShaderSource(METEOR_CULL_SHADER_PATH, source))
+    {
+        printf("GPU culling disabled: cannot read %s\n", METEOR_CULL_SHADER_PATH);
+        return false;
+    }
+    program = compileComputeProgram(source, errorLog);
+    if (!program)
+    {
+        printf("GPU culling disabled: compute shader failed\n%s\n", errorLog.c_str());
+        return false;
+    }
+    glUseProgram(program);
+    glUniform2f(glGetUniformLocation(program, "viewSize"), viewWidth, viewHeight);
+    cullPassLoc = glGetUniformLocation(program, "cullPass");
+    meteorCountLoc = glGetUniformLocation(program, "meteorCount");
+    depthLoc = glGetUniformLocation(program, "depth");
+    dimensionsLoc = glGetUniformLocation(program, "dimensions");
+    offsetTexLoc = glGetUniformLocation(program, "offsetTex");
+    animationLoc = glGetUniformLocation(program, "animation");
+
+    // Deslocamentos das regiões são múltiplos de 64 KB: servem de alinhamento para o SSBO
+    stateStream.create(GL_ARRAY_BUFFER, 4096 * sizeof(MeteorState), allowPersistentMapping, "meteor state");
+
+    glGenBuffers(1, &commandBuffer);
+    glBindBuffer(GL_DRAW_INDIRECT_BUFFER, commandBuffer);
+    glBufferData(GL_DRAW_INDIRECT_BUFFER, sizeof(INITIAL_COMMAND), INITIAL_COMMAND, GL_DYNAMIC_DRAW);
+    glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+    trackBuffer(commandBuffer, sizeof(INITIAL_COMMAND), "meteor draw command");
+    return true;
+}
+
+void GpuCuller::destroy()
+{
+    if (!program)
+        return;
+    stateStream.destroy();
+    glDeleteProgram(program);
+    glDeleteBuffers(1, &commandBuffer);
+    untrack(ResourceKind::Buffer, commandBuffer);
+    if (instances)
+    {
+        GLuint buffers[2] = {instances, groupCounts};
+        glDeleteBuffers(2, buffers);
+        untrack(ResourceKind::Buffer, instances);
+        untrack(ResourceKind::Buffer, groupCounts);
+    }
+    program = commandBuffer = instances = groupCounts = 0;
+}
+
+void GpuCuller::cull(const GpuSpriteField &field, float depthBase, float depthStep)
+{
+    PROFILE_ZONE("gpuCull");
+    size_t count = field.instances.size();
+
+    GLuint groups = (GLuint)((count + CULL_GROUP_SIZE - 1) / CULL_GROUP_SIZE);
+
+    // Pior caso: todos visíveis. Os buffers só crescem e não precisam manter o conteúdo
+    if (count > instanceCapacity)
+    {
+        if (instances)
+        {
+            untrack(ResourceKind::Buffer, instances);
+            untrack(ResourceKind::Buffer, groupCounts);
+        }
+        else
+        {
+            glGenBuffers(1, &instances);
+            glGenBuffers(1, &groupCounts);
+        }
+        instanceCapacity = instanceCapacity ? instanceCapacity : 4096;
+        while (instanceCapacity < count)
+            instanceCapacity *= 2;
+        glBindBuffer(GL_ARRAY_BUFFER, instances);
+        glBufferData(GL_ARRAY_BUFFER, (GLsizeiptr)(instanceCapacity * CULLED_INSTANCE_BYTES), nullptr, GL_DYNAMIC_COPY);
+        trackBuffer(instances, instanceCapacity * CULLED_INSTANCE_BYTES, "culled meteor instances");
+        size_t countBytes = instanceCapacity / CULL_GROUP_SIZE * sizeof(GLuint);
+        glBindBuffer(GL_ARRAY_BUFFER, groupCounts);
+        glBufferData(GL_ARRAY_BUFFER, (GLsizeiptr)countBytes, nullptr, GL_DYNAMIC_COPY);
+        trackBuffer(groupCounts, countBytes, "meteor cull group counts");
+    }
+
+    size_t bytes = count * sizeof(MeteorState);
+    memcpy(stateStream.map(bytes), field.instances.data(), bytes);
+    stateStream.commit(bytes);
+
+    // Comando com o nº de vértices do protótipo; o de instâncias é escrito pelo despacho do meio
+    const GLuint command[4] = {field.prototype.vertexCount, 0, 0, 0};
+    glBindBuffer(GL_DRAW_INDIRECT_BUFFER, commandBuffer);
+    glBufferSubData(GL_DRAW_INDIRECT_BUFFER, 0, sizeof(command), command);
+    glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+
+    const SpriteDraw &prototype = field.prototype;
+    glUseProgram(program);
+    glUniform1ui(meteorCountLoc, (GLuint)count);
+    glUniform2f(depthLoc, depthBase, depthStep);
+    glUniform3f(dimensionsLoc, prototype.dimensions.x, prototype.dimensions.y, prototype.dimensions.z);
+    glUniform2f(offsetTexLoc, prototype.offsetTex.s, prototype.offsetTex.t);
+    glUniform2f(animationLoc, (float)prototype.animFrames, prototype.animFPS);
+    glBindBufferRange(GL_SHADER_STORAGE_BUFFER, 0, stateStream.buffer(), (GLintptr)stateStream.offset(), (GLsizeiptr)bytes);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 1, instances);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 2, commandBuffer);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 3, groupCounts);
+    // Contagem por grupo, soma de prefixos das contagens (um grupo só) e a escrita em ordem
+    glUniform1ui(cullPassLoc, 0);
+    dispatchCompute(groups, 1, 1);
+    memoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT);
+    glUniform1ui(cullPassLoc, 1);
+    dispatchCompute(1, 1, 1);
+    memoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT);
+    glUniform1ui(cullPassLoc, 2);
+    dispatchCompute(groups, 1, 1);
+    // As escritas do compute shader precisam estar visíveis como atributos e como comando indireto
+    memoryBarrier(GL_VERTEX_ATTRIB_ARRAY_BARRIER_BIT | GL_COMMAND_BARRIER_BIT);
+    stateStream.fence();
+
+    dispatches++;
+    if (count > peakMeteors)
+        peakMeteors = count;
+}
+
+void GpuCuller::drawIndirect()
+{
+    glBindBuffer(GL_DRAW_INDIRECT_BUFFER, commandBuffer);
+    drawArraysIndirect(GL_TRIANGLE_STRIP, nullptr);
+    glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+}
+
+void GpuCuller::printSummary() const
+{
+    if (!attempted)
+        return;
+    if (!ready())
+    {
+        printf("GPU culling: unavailable on this GL %d.%d context, meteors culled on the CPU\n", GLVersion.major, GLVersion.minor);
+        return;
+    }
+    printf("GPU culling: %llu frames with three dispatches and one indirect draw, up to %zu meteors per frame\n",
+           (unsigned long long)dispatches, peakMeteors);
+}
@@ -0,0 +1,62 @@
+#pragma once
+
+#include "RenderSnapshot.h"
+#include "StreamBuffer.h"
+
+#include <glad/glad.h>
+
+#include <cstdint>
+
+const char *const METEOR_CULL_SHADER_PATH = "shaders/meteor-cull.comp";
+
+// Descarte e compactação dos meteoros na GPU, para contagens em que montar as instâncias na CPU
+// domina o frame.
+//
+// A CPU só envia o MeteorState de cada meteoro (16 bytes, em um StreamBuffer lido como shader
+// storage buffer). Um compute shader testa cada um contra a vista e escreve os visíveis, já no
+// formato de instância do shader de sprites, em um buffer que só a GPU usa, e o total no
+// instanceCount de um comando indireto. O desenho é um glDrawArraysIndirect: por frame a CPU envia
+// três despachos e um desenho, qualquer que seja o número de meteoros.
+//
+// A compactação é estável: o primeiro despacho conta os visíveis de cada grupo de 64, o segundo
+// (um grupo só) faz a soma de prefixos das contagens e o terceiro escreve cada visível na posição
+// da soma de prefixos, na ordem da lista. Um contador atômico daria
+// uma ordem diferente a cada frame, e na passada translúcida (a folha dos meteoros tem
+// transparência) as bordas sobrepostas trocariam de ordem de mistura e piscariam.
+//
+// Exige um contexto GL 4.3 (compute shader, SSBO e desenho indireto), detectado em setup. O
+// loader do projeto só cobre o 3.3, então as funções novas vêm do GLFW, como em StreamBuffer.
+// Sem suporte, setup retorna false e o jogo continua no descarte da CPU.
+class GpuCuller
+{
+public:
+    bool setup(float viewWidth, float viewHeight, bool allowPersistentMapping);
+    void destroy();
+    bool ready() const { return program != 0; }
+
+    // Envia o estado e despacha o descarte. depthBase: profundidade do meteoro 0; depthStep: passo
+    // entre meteoros seguidos (a mesma ordem da lista de sprites do caminho da CPU)
+    void cull(const GpuSpriteField &field, float depthBase, float depthStep);
+    // Instâncias compactadas (formato do Renderer, sem deslocamento)
+    GLuint instanceBuffer() const { return instances; }
+    // Um desenho indireto com o VAO, a textura e os atributos já ligados pelo Renderer
+    void drawIndirect();
+
+    void printSummary() const;
+
+private:
+    GLuint program = 0;
+    StreamBuffer stateStream;
+    GLuint instances = 0;     // só GPU: escrito pelo compute shader, lido como atributos por instância
+    size_t instanceCapacity = 0;
+    GLuint commandBuffer = 0; // DrawArraysIndirectCommand {count, instanceCount, first, baseInstance}
+    GLuint groupCounts = 0;   // visíveis por grupo de trabalho, depois o início de cada grupo na saída
+    float viewWidth = 0.0f, viewHeight = 0.0f;
+    bool attempted = false; // setup foi chamado (o resumo diz se caiu no caminho da CPU)
+
+    GLint cullPassLoc = -1, meteorCountLoc = -1, depthLoc = -1, dimensionsLoc = -1, offsetTexLoc = -1, animationLoc = -1;
+
+    // Estatísticas
+    uint64_t dispatches = 0;
+    size_t peakMeteors = 0;
+};
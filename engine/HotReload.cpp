@@ -0,0 +1,267 @@
+#include "HotReload.h"
+#include "Log.h"
+#include "ResourceRegistry.h"
+#include "SpriteShader.h"
+
+#include <stb_image/stb_image.h>
+
+#include <cstdio>
+#include <set>
+
+#ifdef __linux__
+#include <poll.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+// Editores costumam gravar em várias etapas; espera o arquivo ficar quieto antes de recarregar
+const int HOT_RELOAD_DEBOUNCE_MS = 50;
+const int HOT_RELOAD_POLL_MS = 100;
+
+// "./textures/a.png" e "textures/a.png" são o mesmo arquivo
+static std::string normalizePath(const std::string &path)
+{
+    std::string normalized = path;
+    while (normalized.compare(0, 2, "./") == 0)
+        normalized.erase(0, 2);
+    return normalized;
+}
+
+bool HotReloader::start(GLFWwindow *mainWindow)
+{
+#ifdef __linux__
+    glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+    context = glfwCreateWindow(1, 1, "Hot reload", nullptr, mainWindow);
+    glfwDefaultWindowHints();
+    if (!context)
+    {
+        printf("Hot reload disabled: cannot create a shared GL context\n");
+        return false;
+    }
+    stopping = false;
+    thread = std::thread(&HotReloader::run, this);
+    printf("Hot reload: watching textures/ and shaders/\n");
+    return true;
+#else
+    (void)mainWindow;
+    printf("Hot reload is only available on Linux\n");
+    return false;
+#endif
+}
+
+void HotReloader::stop()
+{
+    if (thread.joinable())
+    {
+        stopping = true;
+        thread.join();
+    }
+    if (context)
+    {
+        glfwDestroyWindow(context);
+        context = nullptr;
+    }
+
+    // Objetos compartilhados: podem ser apagados pelo contexto do jogo
+    for (PendingReload &reload : pending)
+    {
+        glDeleteSync(reload.fence);
+        if (reload.texture < 0)
+            glDeleteProgram(reload.object);
+        else
+        {
+            untrack(ResourceKind::Texture, reload.object);
+            glDeleteTextures(1, &reload.object);
+        }
+    }
+    pending.clear();
+    for (WatchedTexture &tex : textures)
+    {
+        if (!tex.current)
+            continue;
+        untrack(ResourceKind::Texture, tex.current);
+        glDeleteTextures(1, &tex.current);
+        tex.current = 0;
+    }
+    if (currentShader)
+        glDeleteProgram(currentShader);
+    currentShader = 0;
+}
+
+void HotReloader::watchTexture(const std::string &path, GLuint textureID)
+{
+    WatchedTexture tex;
+    tex.path = normalizePath(path);
+    tex.original = textureID;
+    textures.push_back(tex);
+}
+
+void HotReloader::applyReady(Renderer &renderer)
+{
+    std::lock_guard<std::mutex> lock(pendingMutex);
+    for (size_t i = 0; i < pending.size();)
+    {
+        PendingReload &reload = pending[i];
+        // Sem timeout: se a GPU ainda não terminou o envio, tenta de novo no próximo frame
+        if (glClientWaitSync(reload.fence, 0, 0) == GL_TIMEOUT_EXPIRED)
+        {
+            i++;
+            continue;
+        }
+        glDeleteSync(reload.fence);
+
+        if (reload.texture < 0)
+        {
+            renderer.setShader(reload.object);
+            if (currentShader)
+                glDeleteProgram(currentShader);
+            currentShader = reload.object;
+        }
+        else
+        {
+            WatchedTexture &tex = textures[reload.texture];
+            renderer.setTextureOverride(tex.original, reload.object);
+            if (tex.current)
+            {
+                untrack(ResourceKind::Texture, tex.current);
+                glDeleteTextures(1, &tex.current);
+            }
+            tex.current = reload.object;
+        }
+        pending.erase(pending.begin() + i);
+    }
+}
+
+void HotReloader::queue(int texture, GLuint object)
+{
+    PendingReload reload;
+    reload.texture = texture;
+    reload.object = object;
+    reload.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    // Sem o flush o fence pode nunca chegar à GPU, e a outra thread esperaria para sempre
+    glFlush();
+
+    std::lock_guard<std::mutex> lock(pendingMutex);
+    pending.push_back(reload);
+}
+
+void HotReloader::reload(const std::string &path)
+{
+    if (path == SPRITE_VERTEX_SHADER_PATH || path == SPRITE_FRAGMENT_SHADER_PATH)
+    {
+        reloadShader();
+        return;
+    }
+    for (size_t i = 0; i < textures.size(); i++)
+        if (textures[i].path == path)
+            reloadTexture((int)i);
+}
+
+void HotReloader::reloadTexture(int index)
+{
+    const WatchedTexture &tex = textures[index];
+    int width, height;
+    unsigned char *image = stbi_load(tex.path.c_str(), &width, &height, 0, 4);
+    if (!image)
+    {
+        LOG(LOG_WARN, LOG_RENDER, "hot reload: cannot decode %s", tex.path.c_str());
+        return;
+    }
+
+    // Tamanho e quadros das sprites vêm das dimensões originais
+    GLint originalWidth = 0, originalHeight = 0;
+    glBindTexture(GL_TEXTURE_2D, tex.original);
+    glGetTexLevelParameteriv(GL_TEXTURE_2D, 0, GL_TEXTURE_WIDTH, &originalWidth);
+    glGetTexLevelParameteriv(GL_TEXTURE_2D, 0, GL_TEXTURE_HEIGHT, &originalHeight);
+    if (width != originalWidth || height != originalHeight)
+    {
+        printf("Hot reload: %s is %dx%d, expected %dx%d; keeping the old texture\n", tex.path.c_str(), width, height,
+               originalWidth, originalHeight);
+        stbi_image_free(image);
+        return;
+    }
+
+    // Mesmos parâmetros e alfa pré-multiplicado do loadTexture do jogo
+    premultiplyAlpha(image, width, height);
+    GLuint textureID;
+    glGenTextures(1, &textureID);
+    glBindTexture(GL_TEXTURE_2D, textureID);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, image);
+    glGenerateMipmap(GL_TEXTURE_2D);
+    glBindTexture(GL_TEXTURE_2D, 0);
+    stbi_image_free(image);
+
+    trackTexture(textureID, width, height, GL_RGBA8, mipLevelCount(width, height), "reload " + tex.path);
+    queue(index, textureID);
+    LOG(LOG_INFO, LOG_RENDER, "hot reload: %s", tex.path.c_str());
+}
+
+void HotReloader::reloadShader()
+{
+    std::string vertexSource, fragmentSource, errorLog;
+    if (!readShaderSource(SPRITE_VERTEX_SHADER_PATH, vertexSource) || !readShaderSource(SPRITE_FRAGMENT_SHADER_PATH, fragmentSource))
+        return;
+
+    GLuint program = compileShaderProgram(vertexSource, fragmentSource, errorLog);
+    if (!program)
+    {
+        // O log do compilador é texto dinâmico, então vai direto para a saída e não para o LOG
+        printf("Hot reload: sprite shader rejected, keeping the previous one\n%s\n", errorLog.c_str());
+        return;
+    }
+    queue(-1, program);
+    LOG(LOG_INFO, LOG_RENDER, "hot reload: sprite shader");
+}
+
+void HotReloader::run()
+{
+#ifdef __linux__
+    glfwMakeContextCurrent(context);
+
+    // IN_MOVED_TO cobre os editores que gravam em um temporário e renomeiam
+    int fd = inotify_init1(IN_NONBLOCK);
+    int texturesWatch = fd < 0 ? -1 : inotify_add_watch(fd, "textures", IN_CLOSE_WRITE | IN_MOVED_TO);
+    int shadersWatch = fd < 0 ? -1 : inotify_add_watch(fd, "shaders", IN_CLOSE_WRITE | IN_MOVED_TO);
+    if (texturesWatch < 0 || shadersWatch < 0)
+    {
+        printf("Hot reload disabled: cannot watch textures/ and shaders/\n");
+        if (fd >= 0)
+            close(fd);
+        glfwMakeContextCurrent(nullptr);
+        return;
+    }
+
+    std::set<std::string> changed;
+    alignas(inotify_event) char events[4096];
+    while (!stopping)
+    {
+        pollfd waitFd = {fd, POLLIN, 0};
+        int ready = poll(&waitFd, 1, changed.empty() ? HOT_RELOAD_POLL_MS : HOT_RELOAD_DEBOUNCE_MS);
+        if (ready > 0)
+        {
+            ssize_t length;
+            while ((length = read(fd, events, sizeof(events))) > 0)
+                for (char *p = events; p < events + length;)
+                {
+                    const inotify_event *event = (const inotify_event *)p;
+                    if (event->len)
+                        changed.insert(std::string(event->wd == texturesWatch ? "textures/" : "shaders/") + event->name);
+                    p += sizeof(inotify_event) + event->len;
+                }
+            continue;
+        }
+
+        // Nenhum evento durante o debounce: os arquivos estão prontos
+        for (const std::string &path : changed)
+            reload(path);
+        changed.clear();
+    }
+
+    close(fd);
+    glfwMakeContextCurrent(nullptr);
+#endif
+}
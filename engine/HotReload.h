@@ -0,0 +1,70 @@
+#pragma once
+
+#include "Renderer.h"
+
+#include <glad/glad.h>
+#include <GLFW/glfw3.h>
+
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Recarga a quente de texturas e shaders durante o jogo (--hot-reload).
+//
+// Uma thread observa textures/ e shaders/ (inotify, só no Linux) e, quando um arquivo muda,
+// decodifica e envia a textura ou compila o programa em um contexto GL compartilhado, oculto.
+// Cada recurso novo leva um fence; a thread de renderização só troca para ele (applyReady, entre
+// frames) depois que o fence sinalizou, sem nunca esperar pela GPU. Shader com erro de
+// compilação é rejeitado e o anterior continua em uso.
+//
+// A textura recarregada deve manter as dimensões da original: o tamanho das sprites e a
+// divisão em quadros de animação são fixados no carregamento.
+class HotReloader
+{
+public:
+    // Cria o contexto compartilhado (na thread principal, com a janela do jogo já criada) e
+    // inicia a observação; false se a plataforma ou o contexto não suportarem
+    bool start(GLFWwindow *mainWindow);
+    // Termina a thread e apaga os recursos recarregados; o contexto do jogo deve estar corrente
+    void stop();
+
+    // Registra uma textura carregada do disco (antes de start)
+    void watchTexture(const std::string &path, GLuint textureID);
+
+    // Troca para os recursos prontos; chamado na thread de renderização, antes de desenhar
+    void applyReady(Renderer &renderer);
+
+private:
+    struct WatchedTexture
+    {
+        std::string path;
+        GLuint original = 0;
+        GLuint current = 0; // substituta em uso pelo Renderer (0 = a original)
+    };
+
+    // Recurso novo aguardando o fence da GPU
+    struct PendingReload
+    {
+        int texture = -1; // índice em textures; -1 = programa de shader
+        GLuint object = 0;
+        GLsync fence = nullptr;
+    };
+
+    void run();
+    void reload(const std::string &path);
+    void reloadTexture(int index);
+    void reloadShader();
+    void queue(int texture, GLuint object);
+
+    GLFWwindow *context = nullptr; // janela oculta dona do contexto compartilhado
+    std::thread thread;
+    std::atomic<bool> stopping{false};
+
+    std::vector<WatchedTexture> textures;
+    GLuint currentShader = 0; // programa recarregado em uso (0 = o de setupShader)
+
+    std::mutex pendingMutex;
+    std::vector<PendingReload> pending;
+};
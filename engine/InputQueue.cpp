@@ -0,0 +1,62 @@
+#include "InputQueue.h"
+
+#include <cstdio>
+
+InputLatencyStats inputLatency;
+
+void InputQueue::push(int key, int action, uint64_t tick)
+{
+    if (count == CAPACITY)
+    {
+        droppedCount++;
+        return;
+    }
+    InputEvent &event = events[(head + count) % CAPACITY];
+    event.tick = tick;
+    event.key = (int16_t)key;
+    event.action = (uint8_t)action;
+    count++;
+}
+
+bool InputQueue::pop(uint64_t upTo, InputEvent &event)
+{
+    if (count == 0 || events[head].tick > upTo)
+        return false;
+    event = events[head];
+    head = (head + 1) % CAPACITY;
+    count--;
+    return true;
+}
+
+void InputLatencyStats::record(uint64_t eventTick, uint64_t presentTick)
+{
+    double ms = presentTick > eventTick ? (presentTick - eventTick) / 1000.0 : 0.0;
+    int bucket = (int)(ms * 10.0);
+    histogram[bucket < BUCKETS ? bucket : BUCKETS]++;
+    samples++;
+    sumMs += ms;
+    if (ms > maxMs)
+        maxMs = ms;
+}
+
+void InputLatencyStats::printSummary() const
+{
+    if (samples == 0)
+        return;
+
+    // p50 e p99 pelo histograma (limite superior do balde)
+    double p50 = 0.0, p99 = 0.0;
+    uint64_t seen = 0;
+    for (int i = 0; i <= BUCKETS; i++)
+    {
+        uint64_t before = seen;
+        seen += histogram[i];
+        double upper = i < BUCKETS ? (i + 1) / 10.0 : maxMs;
+        if (before < (samples + 1) / 2 && seen >= (samples + 1) / 2)
+            p50 = upper;
+        if (before < (samples * 99 + 99) / 100 && seen >= (samples * 99 + 99) / 100)
+            p99 = upper;
+    }
+    printf("Input to present latency: %llu events, avg %.2f ms, p50 %.1f ms, p99 %.1f ms, max %.2f ms\n",
+           (unsigned long long)samples, sumMs / samples, p50, p99, maxMs);
+}
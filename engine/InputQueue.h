@@ -0,0 +1,49 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+// Transição de tecla com o instante (ticks do GameClock) em que a GLFW a entregou
+struct InputEvent
+{
+    uint64_t tick;
+    int16_t key;
+    uint8_t action; // GLFW_PRESS ou GLFW_RELEASE
+};
+
+// Fila de eventos de tecla: produzida pelo callback da GLFW e consumida pela simulação uma vez por
+// frame, na mesma thread. Capacidade fixa, sem alocação; se encher, os eventos novos são descartados.
+class InputQueue
+{
+public:
+    static const size_t CAPACITY = 256;
+
+    void push(int key, int action, uint64_t tick);
+    // Retira o evento mais antigo se ele aconteceu até upTo
+    bool pop(uint64_t upTo, InputEvent &event);
+    uint64_t dropped() const { return droppedCount; }
+
+private:
+    InputEvent events[CAPACITY];
+    size_t head = 0, count = 0;
+    uint64_t droppedCount = 0;
+};
+
+// Latência entrada -> apresentação: do evento até o retorno do glfwSwapBuffers do primeiro frame
+// que o reflete. Gravada pela thread de renderização; o resumo é impresso depois que ela termina.
+// O instante do evento é o da entrega pela GLFW (glfwPollEvents), então o tempo que o evento passou
+// na fila do sistema antes do poll não entra na conta.
+class InputLatencyStats
+{
+public:
+    void record(uint64_t eventTick, uint64_t presentTick);
+    void printSummary() const;
+
+private:
+    static const int BUCKETS = 2000; // 0,1 ms cada, até 200 ms
+    uint32_t histogram[BUCKETS + 1] = {};
+    uint64_t samples = 0;
+    double sumMs = 0.0, maxMs = 0.0;
+};
+
+extern InputLatencyStats inputLatency;
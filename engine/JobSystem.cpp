@@ -0,0 +1,243 @@
+#include "JobSystem.h"
+#include "AllocTracker.h"
+#include "Log.h"
+#include "Profiler.h"
+
+#include <cstdio>
+#include <cstring>
+
+// Tentativas sem achar tarefa (cedendo a CPU entre elas) antes de a thread dormir
+const int IDLE_SPINS = 64;
+
+int TaskGraph::add(const char *name, std::function<void()> work)
+{
+    std::unique_ptr<Task> task(new Task());
+    task->name = name;
+    task->zone = profileZoneId(name);
+    task->work = std::move(work);
+    tasks.push_back(std::move(task));
+    return (int)tasks.size() - 1;
+}
+
+void TaskGraph::dependsOn(int task, int prerequisite)
+{
+    tasks[prerequisite]->successors.push_back(task);
+    tasks[task]->dependencies++;
+}
+
+void TaskGraph::printTimings() const
+{
+    if (runs == 0)
+        return;
+
+    uint64_t taskNs = 0;
+    for (const std::unique_ptr<Task> &task : tasks)
+        taskNs += task->totalNs;
+    printf("Task graph over %llu frames: %.3f ms/frame wall, %.3f ms/frame of tasks, parallelism %.2f\n",
+           (unsigned long long)runs, wallNs / 1e6 / runs, taskNs / 1e6 / runs, wallNs ? (double)taskNs / wallNs : 0.0);
+    // Tarefas com o mesmo nome (ex.: as faixas de um laço paralelo) saem somadas em uma linha
+    for (size_t i = 0; i < tasks.size(); i++)
+    {
+        bool printed = false;
+        for (size_t j = 0; j < i && !printed; j++)
+            printed = strcmp(tasks[j]->name, tasks[i]->name) == 0;
+        if (printed)
+            continue;
+
+        uint64_t ns = 0;
+        int count = 0;
+        for (size_t j = i; j < tasks.size(); j++)
+            if (strcmp(tasks[j]->name, tasks[i]->name) == 0)
+            {
+                ns += tasks[j]->totalNs;
+                count++;
+            }
+        printf("  %-20s %8.4f ms", tasks[i]->name, ns / 1e6 / runs);
+        if (count > 1)
+            printf("  (%d tasks)", count);
+        else
+            printf("  (last on worker %d)", tasks[i]->lastWorker);
+        printf("\n");
+    }
+}
+
+void JobSystem::WorkQueue::reserve(int capacity)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    if (capacity <= (int)items.size())
+        return;
+    std::vector<int> grown(capacity);
+    for (int i = 0; i < count; i++)
+        grown[i] = items[(head + i) % items.size()];
+    items.swap(grown);
+    head = 0;
+}
+
+void JobSystem::WorkQueue::push(int task)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    items[(head + count) % items.size()] = task;
+    count++;
+}
+
+bool JobSystem::WorkQueue::popBack(int &task)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    if (count == 0)
+        return false;
+    count--;
+    task = items[(head + count) % items.size()];
+    return true;
+}
+
+bool JobSystem::WorkQueue::stealFront(int &task)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    if (count == 0)
+        return false;
+    task = items[head];
+    head = (head + 1) % items.size();
+    count--;
+    return true;
+}
+
+void JobSystem::start(int workers)
+{
+    queueCount = workers + 1;
+    queues.reset(new WorkQueue[queueCount]);
+    stopping = false;
+    for (int i = 1; i <= workers; i++)
+        threads.emplace_back(&JobSystem::workerLoop, this, i);
+}
+
+void JobSystem::stop()
+{
+    {
+        std::lock_guard<std::mutex> lock(wakeMutex);
+        stopping = true;
+    }
+    wakeWorkers.notify_all();
+    for (std::thread &thread : threads)
+        thread.join();
+    threads.clear();
+}
+
+void JobSystem::run(TaskGraph &graph)
+{
+    uint64_t start = profilerNowNs();
+    this->graph = &graph;
+    for (int i = 0; i < queueCount; i++)
+        queues[i].reserve((int)graph.tasks.size());
+    remaining = (int)graph.tasks.size();
+    for (std::unique_ptr<TaskGraph::Task> &task : graph.tasks)
+        task->pending.store(task->dependencies, std::memory_order_relaxed);
+    for (int i = 0; i < (int)graph.tasks.size(); i++)
+        if (graph.tasks[i]->dependencies == 0)
+            push(0, i);
+
+    if (!threads.empty())
+    {
+        {
+            std::lock_guard<std::mutex> lock(wakeMutex);
+            generation++;
+        }
+        wakeWorkers.notify_all();
+    }
+
+    runUntilDone(0);
+
+    graph.runs++;
+    graph.wallNs += profilerNowNs() - start;
+}
+
+// Pega uma tarefa da própria fila ou rouba de outra; retorna false se não havia nenhuma
+bool JobSystem::runOne(int queue)
+{
+    int task;
+    bool found = queues[queue].popBack(task);
+    for (int i = 1; !found && i < queueCount; i++)
+        found = queues[(queue + i) % queueCount].stealFront(task);
+    if (found)
+        execute(task, queue);
+    return found;
+}
+
+// Executa e rouba tarefas até o grafo terminar. Sem nada para pegar, cede a CPU algumas vezes e
+// depois dorme até uma tarefa nova ser empurrada (ou o grafo acabar)
+void JobSystem::runUntilDone(int queue)
+{
+    int idle = 0;
+    while (remaining.load(std::memory_order_acquire) > 0)
+    {
+        uint64_t seen = pushes.load();
+        if (runOne(queue))
+        {
+            idle = 0;
+            continue;
+        }
+        if (++idle < IDLE_SPINS)
+        {
+            std::this_thread::yield();
+            continue;
+        }
+        std::unique_lock<std::mutex> lock(workMutex);
+        sleepers++;
+        workReady.wait(lock, [&] { return pushes.load() != seen || remaining.load() == 0; });
+        sleepers--;
+        idle = 0;
+    }
+}
+
+// Quem dorme se registra em sleepers antes de conferir pushes (com o mutex): ou vê o push, ou é acordado
+void JobSystem::push(int queue, int task)
+{
+    queues[queue].push(task);
+    pushes++;
+    if (sleepers.load() > 0)
+    {
+        std::lock_guard<std::mutex> lock(workMutex);
+        workReady.notify_all();
+    }
+}
+
+void JobSystem::execute(int index, int queue)
+{
+    TaskGraph::Task &task = *graph->tasks[index];
+    uint64_t start = profilerNowNs();
+    {
+        ProfileZone zone(task.zone);
+        task.work();
+    }
+    task.totalNs += profilerNowNs() - start;
+    task.lastWorker = queue;
+
+    // Sucessores liberados vão para a fila de quem terminou (os dados ainda estão no cache dela)
+    for (int successor : task.successors)
+        if (graph->tasks[successor]->pending.fetch_sub(1, std::memory_order_acq_rel) == 1)
+            push(queue, successor);
+    if (remaining.fetch_sub(1) == 1 && sleepers.load() > 0)
+    {
+        std::lock_guard<std::mutex> lock(workMutex);
+        workReady.notify_all();
+    }
+}
+
+void JobSystem::workerLoop(int index)
+{
+    // As tarefas do grafo fazem parte do laço do jogo (e logam: o buffer de log nasce aqui)
+    allocCheckThread();
+    logRegisterThread();
+    uint64_t seen = 0;
+    for (;;)
+    {
+        {
+            std::unique_lock<std::mutex> lock(wakeMutex);
+            wakeWorkers.wait(lock, [&] { return stopping || generation != seen; });
+            if (stopping)
+                return;
+            seen = generation;
+        }
+
+        runUntilDone(index);
+    }
+}
@@ -0,0 +1,98 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Grafo de tarefas de um frame: montado uma vez e executado a cada frame pelo JobSystem.
+// Executar não aloca: só os contadores de dependência são reiniciados (as filas do JobSystem só
+// crescem na primeira execução de um grafo maior).
+class TaskGraph
+{
+public:
+    // Nome literal: também vira a zona de profiling da tarefa
+    int add(const char *name, std::function<void()> work);
+    // task só começa depois que prerequisite terminar
+    void dependsOn(int task, int prerequisite);
+    size_t size() const { return tasks.size(); }
+
+    // Tempo médio de cada tarefa, em que thread rodou por último e o paralelismo obtido
+    // (soma dos tempos das tarefas / tempo de parede do grafo)
+    void printTimings() const;
+
+private:
+    friend class JobSystem;
+
+    struct Task
+    {
+        const char *name;
+        int zone;
+        std::function<void()> work;
+        std::vector<int> successors;
+        int dependencies = 0;
+        std::atomic<int> pending{0};
+        uint64_t totalNs = 0;
+        int lastWorker = 0;
+    };
+
+    std::vector<std::unique_ptr<Task>> tasks;
+    uint64_t runs = 0;
+    uint64_t wallNs = 0;
+};
+
+// Pool fixo de threads com roubo de trabalho: cada thread tem sua fila (LIFO para a dona, FIFO para
+// quem rouba). A thread que chama run participa como fila 0 e só retorna quando o grafo termina.
+// Sem tarefa para pegar, uma thread gira um pouco e depois dorme até alguém empurrar trabalho.
+class JobSystem
+{
+public:
+    // workers = 0: tudo roda na thread chamadora, na ordem das dependências
+    void start(int workers);
+    void stop();
+    int workers() const { return (int)threads.size(); }
+
+    void run(TaskGraph &graph);
+
+private:
+    // Cada tarefa entra em uma fila no máximo uma vez por execução: capacidade = tamanho do grafo
+    struct WorkQueue
+    {
+        std::mutex mutex;
+        std::vector<int> items;
+        int head = 0, count = 0;
+
+        void reserve(int capacity);
+        void push(int task);
+        bool popBack(int &task);
+        bool stealFront(int &task);
+    };
+
+    void workerLoop(int index);
+    bool runOne(int queue);
+    void runUntilDone(int queue);
+    void push(int queue, int task);
+    void execute(int task, int queue);
+
+    std::vector<std::thread> threads;
+    std::unique_ptr<WorkQueue[]> queues;
+    int queueCount = 1;
+
+    TaskGraph *graph = nullptr;
+    std::atomic<int> remaining{0};
+
+    // Threads dormindo à espera de trabalho; pushes muda a cada tarefa empurrada
+    std::mutex workMutex;
+    std::condition_variable workReady;
+    std::atomic<uint64_t> pushes{0};
+    std::atomic<int> sleepers{0};
+
+    std::mutex wakeMutex;
+    std::condition_variable wakeWorkers;
+    uint64_t generation = 0;
+    bool stopping = false;
+};
@@ -0,0 +1,307 @@
+#include "Log.h"
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+std::atomic<uint8_t> logMinLevel[LOG_CATEGORY_COUNT];
+
+static const char *levelNames[] = {"trace", "debug", "info", "warn", "error", "off"};
+static const char *categoryNames[] = {"game", "collision", "spawn", "input", "render", "engine"};
+
+struct LogRecord
+{
+    uint64_t ns; // desde logStart
+    const char *format;
+    LogLevel level;
+    LogCategory category;
+    uint8_t argCount;
+    uint32_t thread;
+    LogArg args[LOG_MAX_ARGS];
+};
+
+// Buffer circular de uma thread: um produtor (a thread dona) e um consumidor (a thread de escrita)
+struct LogRing
+{
+    static const uint32_t CAPACITY = 1024; // potência de 2
+    LogRecord records[CAPACITY];
+    std::atomic<uint32_t> head{0}; // próxima escrita (produtor)
+    std::atomic<uint32_t> tail{0}; // próxima leitura (consumidor)
+    uint32_t thread = 0;
+};
+
+static std::chrono::steady_clock::time_point origin;
+static FILE *output = nullptr;
+static std::atomic<bool> running{false};
+static std::atomic<uint64_t> dropped{0};
+
+static std::mutex ringsMutex;
+static std::vector<std::unique_ptr<LogRing>> rings;
+static thread_local LogRing *threadRing = nullptr;
+
+static std::thread writer;
+static std::mutex writerMutex;
+static std::condition_variable writerWake;
+static bool writerStop = false;
+
+
+// Primeira chamada em cada thread: cria e registra o buffer dela (única alocação do caminho)
+static LogRing *ringForThread()
+{
+    std::lock_guard<std::mutex> lock(ringsMutex);
+    rings.emplace_back(new LogRing());
+    threadRing = rings.back().get();
+    threadRing->thread = (uint32_t)rings.size();
+    return threadRing;
+}
+
+void logRegisterThread()
+{
+    if (!threadRing)
+        ringForThread();
+}
+
+void logPush(LogLevel level, LogCategory category, const char *format, const LogArg *args, int argCount)
+{
+    if (!running.load(std::memory_order_relaxed))
+        return;
+    LogRing *ring = threadRing ? threadRing : ringForThread();
+
+    uint32_t head = ring->head.load(std::memory_order_relaxed);
+    if (head - ring->tail.load(std::memory_order_acquire) == LogRing::CAPACITY)
+    {
+        dropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    LogRecord &record = ring->records[head & (LogRing::CAPACITY - 1)];
+    record.ns = (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - origin).count();
+    record.format = format;
+    record.level = level;
+    record.category = category;
+    record.argCount = (uint8_t)argCount;
+    record.thread = ring->thread;
+    for (int i = 0; i < argCount; i++)
+        record.args[i] = args[i];
+    ring->head.store(head + 1, std::memory_order_release);
+
+    // Metade do buffer ocupada: acorda a escrita antes do próximo ciclo para não descartar
+    if (head - ring->tail.load(std::memory_order_relaxed) == LogRing::CAPACITY / 2)
+        writerWake.notify_one();
+}
+
+// Formata como printf, mas com os argumentos guardados: cada conversão vira um snprintf com o tipo
+// que foi gravado (os modificadores de tamanho do formato original são trocados pelo do tipo)
+static void formatRecord(const LogRecord &record, std::string &line)
+{
+    char buffer[256];
+    snprintf(buffer, sizeof(buffer), "%10.3f ms [%s] %-9s t%u ", record.ns / 1e6, levelNames[record.level],
+             categoryNames[record.category], record.thread);
+    line += buffer;
+
+    int next = 0;
+    for (const char *c = record.format; *c; c++)
+    {
+        if (*c != '%')
+        {
+            line += *c;
+            continue;
+        }
+        if (c[1] == '%')
+        {
+            line += '%';
+            c++;
+            continue;
+        }
+
+        // Flags, largura e precisão são mantidos; comprimento (h, l, ll, z, j, t) é descartado
+        std::string spec = "%";
+        const char *p = c + 1;
+        while (*p && strchr("-+ #0123456789.", *p))
+            spec += *p++;
+        while (*p && strchr("hlLzjt", *p))
+            p++;
+        char conversion = *p;
+        if (!conversion)
+            break;
+        c = p;
+
+        if (next >= record.argCount)
+        {
+            line += "<missing>";
+            continue;
+        }
+        const LogArg &arg = record.args[next++];
+        if (strchr("diouxXc", conversion))
+        {
+            spec += (conversion == 'c') ? "c" : std::string("ll") + conversion;
+            if (conversion == 'c')
+                snprintf(buffer, sizeof(buffer), spec.c_str(), (int)arg.i);
+            else if (arg.type == LogArg::DOUBLE)
+                snprintf(buffer, sizeof(buffer), spec.c_str(), (long long)arg.d);
+            else
+                snprintf(buffer, sizeof(buffer), spec.c_str(), (long long)arg.i);
+        }
+        else if (strchr("eEfFgGaA", conversion))
+        {
+            spec += conversion;
+            double value = arg.type == LogArg::DOUBLE ? arg.d : arg.type == LogArg::INT ? (double)arg.i : (double)arg.u;
+            snprintf(buffer, sizeof(buffer), spec.c_str(), value);
+        }
+        else if (conversion == 's')
+        {
+            spec += 's';
+            snprintf(buffer, sizeof(buffer), spec.c_str(), arg.type == LogArg::STRING && arg.s ? arg.s : "(null)");
+        }
+        else
+        {
+            spec += 'p';
+            snprintf(buffer, sizeof(buffer), spec.c_str(), arg.p);
+        }
+        line += buffer;
+    }
+    line += '\n';
+}
+
+// Esvazia os buffers de todas as threads e escreve em ordem de tempo
+static void drain(std::vector<LogRecord> &batch, std::string &text)
+{
+    batch.clear();
+    {
+        std::lock_guard<std::mutex> lock(ringsMutex);
+        // Cabe tudo sem crescer no meio da cópia; só aloca quando uma thread nova registra o buffer
+        batch.reserve(rings.size() * LogRing::CAPACITY);
+        for (std::unique_ptr<LogRing> &ring : rings)
+        {
+            uint32_t tail = ring->tail.load(std::memory_order_relaxed);
+            uint32_t head = ring->head.load(std::memory_order_acquire);
+            for (; tail != head; tail++)
+                batch.push_back(ring->records[tail & (LogRing::CAPACITY - 1)]);
+            ring->tail.store(tail, std::memory_order_release);
+        }
+    }
+    if (batch.empty())
+        return;
+
+    std::stable_sort(batch.begin(), batch.end(), [](const LogRecord &a, const LogRecord &b) { return a.ns < b.ns; });
+    text.clear();
+    for (const LogRecord &record : batch)
+        formatRecord(record, text);
+    fwrite(text.data(), 1, text.size(), output);
+    fflush(output);
+}
+
+static void writerLoop()
+{
+    // A thread de escrita fica fora da checagem de alocações, mas reserva o de sempre de uma vez
+    std::vector<LogRecord> batch;
+    std::string text;
+    text.reserve(64 * 1024);
+    std::unique_lock<std::mutex> lock(writerMutex);
+    while (!writerStop)
+    {
+        writerWake.wait_for(lock, std::chrono::milliseconds(10));
+        lock.unlock();
+        drain(batch, text);
+        lock.lock();
+    }
+    lock.unlock();
+    drain(batch, text);
+}
+
+bool parseLogLevels(const char *text, LogConfig &config)
+{
+    std::string list = text;
+    size_t start = 0;
+    while (start <= list.size())
+    {
+        size_t end = list.find(',', start);
+        if (end == std::string::npos)
+            end = list.size();
+        std::string item = list.substr(start, end - start);
+        start = end + 1;
+
+        std::string category, level = item;
+        size_t equals = item.find('=');
+        if (equals != std::string::npos)
+        {
+            category = item.substr(0, equals);
+            level = item.substr(equals + 1);
+        }
+
+        int levelIndex = -1;
+        for (int i = 0; i <= LOG_OFF; i++)
+            if (level == levelNames[i])
+                levelIndex = i;
+        if (levelIndex < 0)
+            return false;
+
+        if (category.empty())
+        {
+            for (LogLevel &l : config.levels)
+                l = (LogLevel)levelIndex;
+            continue;
+        }
+        int categoryIndex = -1;
+        for (int i = 0; i < LOG_CATEGORY_COUNT; i++)
+            if (category == categoryNames[i])
+                categoryIndex = i;
+        if (categoryIndex < 0)
+            return false;
+        config.levels[categoryIndex] = (LogLevel)levelIndex;
+    }
+    return true;
+}
+
+void logStart(const LogConfig &config)
+{
+    output = config.path ? fopen(config.path, "w") : stderr;
+    if (!output)
+    {
+        printf("Cannot open log file %s, logging to stderr\n", config.path);
+        output = stderr;
+    }
+    for (int i = 0; i < LOG_CATEGORY_COUNT; i++)
+        logMinLevel[i].store(config.levels[i], std::memory_order_relaxed);
+
+    origin = std::chrono::steady_clock::now();
+    writerStop = false;
+    running = true;
+    writer = std::thread(writerLoop);
+
+    // Saídas antecipadas (return no meio do main, exit) também esvaziam o log e juntam a thread
+    static bool exitHook = atexit(logStop) == 0;
+    (void)exitHook;
+}
+
+void logStop()
+{
+    if (!running)
+        return;
+    running = false;
+    {
+        std::lock_guard<std::mutex> lock(writerMutex);
+        writerStop = true;
+    }
+    writerWake.notify_one();
+    writer.join();
+
+    if (dropped.load())
+        fprintf(output, "%llu log records dropped (ring full)\n", (unsigned long long)dropped.load());
+    if (output != stderr)
+        fclose(output);
+    output = nullptr;
+}
+
+uint64_t logDropped()
+{
+    return dropped.load();
+}
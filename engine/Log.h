@@ -0,0 +1,142 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <type_traits>
+
+// Log assíncrono para caminhos quentes: cada thread escreve registros binários (formato + argumentos
+// crus) em seu próprio buffer circular sem trava; a formatação e a escrita acontecem em uma thread
+// de fundo. Com o buffer cheio o registro é descartado e contado, nunca bloqueia quem loga.
+//
+// Os argumentos são copiados por valor; strings (%s) precisam ser literais ou durar até a escrita.
+
+enum LogLevel : uint8_t
+{
+    LOG_TRACE,
+    LOG_DEBUG,
+    LOG_INFO,
+    LOG_WARN,
+    LOG_ERROR,
+    LOG_OFF
+};
+
+enum LogCategory : uint8_t
+{
+    LOG_GAME,
+    LOG_COLLISION,
+    LOG_SPAWN,
+    LOG_INPUT,
+    LOG_RENDER,
+    LOG_ENGINE,
+    LOG_CATEGORY_COUNT
+};
+
+struct LogConfig
+{
+    const char *path = nullptr; // nullptr: stderr
+    LogLevel levels[LOG_CATEGORY_COUNT] = {LOG_INFO, LOG_INFO, LOG_INFO, LOG_INFO, LOG_INFO, LOG_INFO};
+};
+
+// Lê "debug" (todas as categorias) ou "collision=trace,spawn=debug"; false se inválido
+bool parseLogLevels(const char *text, LogConfig &config);
+
+void logStart(const LogConfig &config);
+// Escreve o que falta e termina a thread de escrita
+void logStop();
+uint64_t logDropped();
+// Cria agora o buffer da thread chamadora (~120 KB), que senão nasce no primeiro LOG dela: threads
+// que logam dentro da checagem de alocações chamam no início
+void logRegisterThread();
+
+const int LOG_MAX_ARGS = 6;
+
+struct LogArg
+{
+    enum Type : uint8_t
+    {
+        INT,
+        UINT,
+        DOUBLE,
+        STRING,
+        POINTER
+    };
+    Type type;
+    union
+    {
+        int64_t i;
+        uint64_t u;
+        double d;
+        const char *s;
+        const void *p;
+    };
+};
+
+extern std::atomic<uint8_t> logMinLevel[LOG_CATEGORY_COUNT];
+
+inline bool logEnabled(LogLevel level, LogCategory category)
+{
+    return level >= logMinLevel[category].load(std::memory_order_relaxed);
+}
+
+template <typename T>
+inline LogArg logArg(T value)
+{
+    LogArg arg;
+    if (std::is_floating_point<T>::value)
+    {
+        arg.type = LogArg::DOUBLE;
+        arg.d = (double)value;
+    }
+    else if (std::is_signed<T>::value)
+    {
+        arg.type = LogArg::INT;
+        arg.i = (int64_t)value;
+    }
+    else
+    {
+        arg.type = LogArg::UINT;
+        arg.u = (uint64_t)value;
+    }
+    return arg;
+}
+
+inline LogArg logArg(const char *value)
+{
+    LogArg arg;
+    arg.type = LogArg::STRING;
+    arg.s = value;
+    return arg;
+}
+
+inline LogArg logArg(char *value)
+{
+    return logArg((const char *)value);
+}
+
+template <typename T>
+inline LogArg logArg(T *value)
+{
+    LogArg arg;
+    arg.type = LogArg::POINTER;
+    arg.p = (const void *)value;
+    return arg;
+}
+
+void logPush(LogLevel level, LogCategory category, const char *format, const LogArg *args, int argCount);
+
+template <typename... Args>
+inline void logWrite(LogLevel level, LogCategory category, const char *format, const Args &...args)
+{
+    static_assert(sizeof...(Args) <= LOG_MAX_ARGS, "too many log arguments");
+    LogArg packed[sizeof...(Args) + 1] = {logArg(args)...};
+    logPush(level, category, format, packed, (int)sizeof...(Args));
+}
+
+// LOG(LOG_DEBUG, LOG_COLLISION, "meteor %d hit at %.1f", index, x);
+// Filtrado antes de avaliar os argumentos: desligado custa uma leitura atômica e uma comparação.
+#define LOG(level, category, ...)                      \
+    do                                                 \
+    {                                                  \
+        if (logEnabled(level, category))               \
+            logWrite(level, category, __VA_ARGS__);    \
+    } while (0)
@@ -0,0 +1,208 @@
+#include "Options.h"
+
+#include <climits>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <sstream>
+
+// Converte um inteiro positivo; retorna false se o texto não for válido
+static bool parsePositive(const char *text, int &value)
+{
+    char *end = nullptr;
+    long parsed = strtol(text, &end, 10);
+    if (end == text || *end != '\0' || parsed <= 0 || parsed > INT_MAX)
+        return false;
+    value = (int)parsed;
+    return true;
+}
+
+// Converte um número real positivo
+static bool parsePositiveReal(const char *text, double &value)
+{
+    char *end = nullptr;
+    double parsed = strtod(text, &end);
+    if (end == text || *end != '\0' || !(parsed > 0.0))
+        return false;
+    value = parsed;
+    return true;
+}
+
+// Lista separada por vírgulas, ex.: "5,50,500"
+static bool parseList(const char *text, std::vector<int> &values)
+{
+    std::stringstream ss(text);
+    std::string item;
+    while (std::getline(ss, item, ','))
+    {
+        int value;
+        if (!parsePositive(item.c_str(), value))
+            return false;
+        values.push_back(value);
+    }
+    return !values.empty();
+}
+
+void printUsage(const char *program)
+{
+    printf("Usage: %s [options]\n", program);
+    printf("  --benchmark          run headless benchmark and exit\n");
+    printf("  --frames N           measured frames per run (default 1000)\n");
+    printf("  --meteors N          meteor count (default 5)\n");
+    printf("  --seed N             random seed (default 42)\n");
+    printf("  --sweep A,B,C        benchmark each meteor count and print a scaling curve\n");
+    printf("  --offscreen          use the GLFW null platform with an OSMesa context\n");
+    printf("  --startup-report     print startup phase timings and exit after the first frame\n");
+    printf("  --alloc-check N      report heap allocations in RUNNING after N warm-up frames\n");
+    printf("  --alloc-abort        like --alloc-check, but abort on the first allocation\n");
+    printf("  --vsync              pace frames with vsync (default)\n");
+    printf("  --fps N              cap the frame rate at N frames per second without vsync\n");
+    printf("  --uncapped           no vsync and no frame cap\n");
+    printf("  --single-thread      render on the simulation thread instead of a render thread\n");
+    printf("  --no-idle            redraw the start and game-over screens every frame\n");
+    printf("  --flight-record PATH flight recorder dump file (default flight-recorder.bin, F2 dumps)\n");
+    printf("  --capture PATH       record every submitted draw to PATH for tools/replay\n");
+    printf("  --time-scale K|max   simulated seconds per wall second (0.25 slow motion, 8 fast-forward)\n");
+    printf("  --no-render          simulate only, without drawing or presenting frames\n");
+    printf("  --log PATH           write the async log to PATH instead of stderr\n");
+    printf("  --log-level SPEC     log level (trace, debug, info, warn, error, off), globally or per\n");
+    printf("                       category, e.g. debug or collision=trace,spawn=debug\n");
+    printf("  --jobs N             worker threads for the per-frame task graph (0 runs it inline)\n");
+    printf("  --no-persistent-map  stream sprite data with glMapBufferRange even if glBufferStorage exists\n");
+    printf("  --single-pass        draw everything blended in list order (no opaque pass or depth rejection)\n");
+    printf("  --overdraw           count shaded fragments per pixel with the stencil buffer and report on exit\n");
+    printf("  --dynamic-res        scale the scene between 50%% and 100%% of the window to hold the frame rate\n");
+    printf("  --particles N        keep N extra particles alive to stress the particle system\n");
+    printf("  --scalar-particles   integrate particles with the scalar loop instead of SSE2/NEON\n");
+    printf("  --no-cull            submit off-screen meteors too (no view culling)\n");
+    printf("  --no-gpu-cull        cull meteors on the CPU even if compute shaders are available\n");
+    printf("  --full-quads         draw sprites as full quads instead of outlines trimmed to visible pixels\n");
+#if DEBUG_DRAW_ENABLED
+    printf("  --debug-draw LIST    show debug geometry: aabb,pairs,cells or all (F3-F5 toggle in game)\n");
+#endif
+    printf("  --hot-reload         reload edited textures and shaders while the game runs (Linux)\n");
+    printf("  --soak SECONDS       autopilot until SECONDS of game time are simulated, then report\n");
+}
+
+bool parseOptions(int argc, char **argv, AppOptions &options)
+{
+    BenchmarkConfig &bench = options.benchmark;
+
+    for (int i = 1; i < argc; i++)
+    {
+        const char *arg = argv[i];
+        const char *next = (i + 1 < argc) ? argv[i + 1] : nullptr;
+        bool ok = true;
+
+        if (strcmp(arg, "--benchmark") == 0)
+            bench.enabled = true;
+        else if (strcmp(arg, "--offscreen") == 0)
+            bench.offscreen = true;
+        else if (strcmp(arg, "--startup-report") == 0)
+            options.startupReport = true;
+        else if (strcmp(arg, "--alloc-check") == 0 && next)
+        {
+            ok = parsePositive(argv[++i], options.allocCheck.warmupFrames);
+            options.allocCheck.enabled = true;
+        }
+        else if (strcmp(arg, "--alloc-abort") == 0)
+        {
+            options.allocCheck.enabled = true;
+            options.allocCheck.abortOnAlloc = true;
+        }
+        else if (strcmp(arg, "--vsync") == 0)
+            options.pacing.mode = PacingMode::VSync;
+        else if (strcmp(arg, "--uncapped") == 0)
+            options.pacing.mode = PacingMode::Uncapped;
+        else if (strcmp(arg, "--fps") == 0 && next)
+        {
+            int fps = 0;
+            ok = parsePositive(argv[++i], fps);
+            options.pacing.mode = PacingMode::Capped;
+            options.pacing.targetFps = fps;
+        }
+        else if (strcmp(arg, "--single-thread") == 0)
+            options.renderThread = false;
+        else if (strcmp(arg, "--no-idle") == 0)
+            options.idleRendering = false;
+        else if (strcmp(arg, "--flight-record") == 0 && next)
+            options.flightRecordPath = argv[++i];
+        else if (strcmp(arg, "--capture") == 0 && next)
+            options.capturePath = argv[++i];
+        else if (strcmp(arg, "--hot-reload") == 0)
+            options.hotReload = true;
+        else if (strcmp(arg, "--no-persistent-map") == 0)
+            options.persistentMapping = false;
+        else if (strcmp(arg, "--single-pass") == 0)
+            options.layeredPasses = false;
+        else if (strcmp(arg, "--overdraw") == 0)
+            options.measureOverdraw = true;
+        else if (strcmp(arg, "--dynamic-res") == 0)
+            options.dynamicResolution = true;
+        else if (strcmp(arg, "--particles") == 0 && next)
+            ok = parsePositive(argv[++i], options.particles);
+        else if (strcmp(arg, "--scalar-particles") == 0)
+            options.simdParticles = false;
+        else if (strcmp(arg, "--no-cull") == 0)
+            options.viewCulling = false;
+        else if (strcmp(arg, "--no-gpu-cull") == 0)
+            options.gpuCulling = false;
+        else if (strcmp(arg, "--full-quads") == 0)
+            options.trimmedSprites = false;
+#if DEBUG_DRAW_ENABLED
+        else if (strcmp(arg, "--debug-draw") == 0 && next)
+            ok = parseDebugDrawFlags(argv[++i], options.debugDraw);
+#endif
+        else if (strcmp(arg, "--time-scale") == 0 && next)
+        {
+            i++;
+            if (strcmp(argv[i], "max") == 0)
+                options.timeScale.scale = 0.0;
+            else
+                ok = parsePositiveReal(argv[i], options.timeScale.scale);
+        }
+        else if (strcmp(arg, "--log") == 0 && next)
+            options.log.path = argv[++i];
+        else if (strcmp(arg, "--log-level") == 0 && next)
+            ok = parseLogLevels(argv[++i], options.log);
+        else if (strcmp(arg, "--jobs") == 0 && next)
+        {
+            char *end = nullptr;
+            long workers = strtol(argv[++i], &end, 10);
+            ok = end != argv[i] && *end == '\0' && workers >= 0 && workers <= 64;
+            options.jobWorkers = (int)workers;
+        }
+        else if (strcmp(arg, "--no-render") == 0)
+            options.timeScale.render = false;
+        else if (strcmp(arg, "--soak") == 0 && next)
+            ok = parsePositiveReal(argv[++i], options.timeScale.soakSeconds);
+        else if (strcmp(arg, "--frames") == 0 && next)
+            ok = parsePositive(argv[++i], bench.frames);
+        else if (strcmp(arg, "--meteors") == 0 && next)
+            ok = parsePositive(argv[++i], bench.meteors);
+        else if (strcmp(arg, "--seed") == 0 && next)
+        {
+            // Semente inválida não pode virar 0 em silêncio: a reprodutibilidade depende dela
+            char *end = nullptr;
+            const char *text = argv[++i];
+            unsigned long long seed = strtoull(text, &end, 10);
+            ok = end != text && *end == '\0' && text[0] != '-' && seed <= 0xFFFFFFFFull;
+            bench.seed = (unsigned int)seed;
+        }
+        else if (strcmp(arg, "--sweep") == 0 && next)
+        {
+            ok = parseList(argv[++i], bench.sweep);
+            bench.enabled = true;
+        }
+        else
+            ok = false;
+
+        if (!ok)
+        {
+            printf("Invalid argument: %s\n", arg);
+            printUsage(argv[0]);
+            return false;
+        }
+    }
+    return true;
+}
@@ -0,0 +1,41 @@
+#pragma once
+
+#include "AllocTracker.h"
+#include "Benchmark.h"
+#include "DebugDraw.h"
+#include "FramePacer.h"
+#include "Log.h"
+#include "TimeScale.h"
+
+// Opções de linha de comando do jogo
+struct AppOptions
+{
+    BenchmarkConfig benchmark;
+    bool startupReport = false; // imprime o relatório de inicialização e sai após o primeiro frame
+    AllocCheckConfig allocCheck;
+    FramePacingConfig pacing;
+    bool renderThread = true;  // GL em uma thread própria, consumindo snapshots da simulação
+    bool idleRendering = true; // telas de início/fim de jogo só redesenham quando algo muda
+    const char *flightRecordPath = "flight-recorder.bin"; // destino do gravador de voo
+    const char *capturePath = nullptr;                    // grava o fluxo de desenho para tools/replay
+    TimeScaleConfig timeScale;
+    LogConfig log;
+    int jobWorkers = -1; // threads do pool de tarefas do frame (-1: automático, 0: tudo na simulação)
+    bool hotReload = false; // recarrega texturas e shaders alterados no disco durante o jogo
+    bool persistentMapping = true; // buffer de instâncias com glBufferStorage quando disponível
+    bool layeredPasses = true;     // passadas opaca e translúcida (false: tudo com blending, em ordem)
+    bool measureOverdraw = false;  // fragmentos sombreados por pixel, impressos ao sair
+    bool dynamicResolution = false; // escala da cena entre 50% e 100% conforme o tempo de GPU
+    int particles = 0;              // partículas vivas mantidas por um emissor de estresse (0: só as do jogo)
+    bool simdParticles = true;      // integração das partículas com SSE2/NEON (false: laço escalar)
+    bool viewCulling = true;        // meteoros fora da tela não entram na lista de desenho
+    bool gpuCulling = true;         // descarte dos meteoros em compute shader quando o contexto é 4.3+
+    bool trimmedSprites = true;     // geometria das sprites recortada em volta dos pixels visíveis
+#if DEBUG_DRAW_ENABLED
+    uint32_t debugDraw = 0;         // grupos da camada de depuração ligados no início (DebugDrawFlag)
+#endif
+};
+
+// Lê os argumentos; retorna false (e imprime o uso) se algum for inválido
+bool parseOptions(int argc, char **argv, AppOptions &options);
+void printUsage(const char *program);
@@ -0,0 +1,104 @@
+#include "Parallax.h"
+#include "Renderer.h"
+#include "ResourceRegistry.h"
+#include "SpriteShader.h"
+
+#include <stb_image/stb_image.h>
+
+#include <cmath>
+#include <cstdio>
+#include <string>
+
+bool ParallaxBackground::setup(float viewWidth, float viewHeight)
+{
+    std::string vertexSource, fragmentSource, errorLog;
+    if (!readShaderSource(PARALLAX_VERTEX_SHADER_PATH, vertexSource) || !readShaderSource(PARALLAX_FRAGMENT_SHADER_PATH, fragmentSource))
+    {
+        printf("Parallax background disabled: cannot read %s or %s\n", PARALLAX_VERTEX_SHADER_PATH, PARALLAX_FRAGMENT_SHADER_PATH);
+        return false;
+    }
+
+    // Todas as camadas vão para uma textura array: uma ligação e um desenho para o fundo inteiro
+    int width = 0, height = 0;
+    for (int layer = 0; layer < PARALLAX_LAYER_COUNT; layer++)
+    {
+        int layerWidth, layerHeight;
+        unsigned char *image = stbi_load(PARALLAX_LAYERS[layer].path, &layerWidth, &layerHeight, 0, 4);
+        if (!image || (layer > 0 && (layerWidth != width || layerHeight != height)))
+        {
+            printf("Parallax background disabled: %s is missing or differs in size from the first layer\n", PARALLAX_LAYERS[layer].path);
+            stbi_image_free(image);
+            destroy();
+            return false;
+        }
+        if (layer == 0)
+        {
+            width = layerWidth;
+            height = layerHeight;
+            glGenTextures(1, &textureArray);
+            glBindTexture(GL_TEXTURE_2D_ARRAY, textureArray);
+            glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, GL_REPEAT);
+            glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, GL_REPEAT);
+            glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+            glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+            glTexImage3D(GL_TEXTURE_2D_ARRAY, 0, GL_RGBA8, width, height, PARALLAX_LAYER_COUNT, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+        }
+        premultiplyAlpha(image, width, height);
+        glTexSubImage3D(GL_TEXTURE_2D_ARRAY, 0, 0, 0, layer, width, height, 1, GL_RGBA, GL_UNSIGNED_BYTE, image);
+        stbi_image_free(image);
+    }
+    glGenerateMipmap(GL_TEXTURE_2D_ARRAY);
+    glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+    // As camadas empilhadas contam como uma textura alta para a estimativa de memória
+    trackTexture(textureArray, width, height * PARALLAX_LAYER_COUNT, GL_RGBA8, mipLevelCount(width, height), "parallax background");
+
+    program = compileShaderProgram(vertexSource, fragmentSource, errorLog);
+    if (!program)
+    {
+        printf("Parallax background disabled: shader failed\n%s\n", errorLog.c_str());
+        destroy();
+        return false;
+    }
+    glGenVertexArrays(1, &VAO);
+
+    // Estado fixo do programa
+    glUseProgram(program);
+    glUniform2f(glGetUniformLocation(program, "viewSize"), viewWidth, viewHeight);
+    glUniform1i(glGetUniformLocation(program, "layers"), 0);
+    float tileSizes[PARALLAX_LAYER_COUNT];
+    for (int layer = 0; layer < PARALLAX_LAYER_COUNT; layer++)
+        tileSizes[layer] = PARALLAX_LAYERS[layer].tileSize;
+    glUniform1fv(glGetUniformLocation(program, "tileSize"), PARALLAX_LAYER_COUNT, tileSizes);
+    scrollLoc = glGetUniformLocation(program, "scroll");
+    firstLayerLoc = glGetUniformLocation(program, "firstLayer");
+    return true;
+}
+
+void ParallaxBackground::destroy()
+{
+    if (textureArray)
+    {
+        glDeleteTextures(1, &textureArray);
+        untrack(ResourceKind::Texture, textureArray);
+    }
+    if (program)
+        glDeleteProgram(program);
+    if (VAO)
+        glDeleteVertexArrays(1, &VAO);
+    textureArray = program = VAO = 0;
+}
+
+void ParallaxBackground::draw(double scroll, int firstLayer, int layerCount)
+{
+    // Reduzido a uma repetição em double: o float do shader não perde precisão em partidas longas
+    float offsets[PARALLAX_LAYER_COUNT];
+    for (int layer = 0; layer < PARALLAX_LAYER_COUNT; layer++)
+        offsets[layer] = (float)std::fmod(scroll * PARALLAX_LAYERS[layer].speed, (double)PARALLAX_LAYERS[layer].tileSize);
+
+    glUseProgram(program);
+    glUniform1fv(scrollLoc, PARALLAX_LAYER_COUNT, offsets);
+    glUniform1i(firstLayerLoc, firstLayer);
+    glBindTexture(GL_TEXTURE_2D_ARRAY, textureArray);
+    glBindVertexArray(VAO);
+    glDrawArraysInstanced(GL_TRIANGLE_STRIP, 0, 4, layerCount);
+}
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <glad/glad.h>
+
+// Fundo em parallax: camadas pequenas que se repetem (GL_REPEAT) em uma textura array, rolando
+// na horizontal em velocidades diferentes. Cada grupo de camadas sai em um único desenho instanciado.
+struct ParallaxLayer
+{
+    const char *path;
+    float speed;    // fração do deslocamento dos meteoros (camadas distantes andam menos)
+    float tileSize; // pixels na tela por repetição da textura
+};
+
+// Da mais distante (opaca) para a mais próxima; todas as imagens devem ter o mesmo tamanho
+const int PARALLAX_LAYER_COUNT = 3;
+const ParallaxLayer PARALLAX_LAYERS[PARALLAX_LAYER_COUNT] = {
+    {"textures/parallax-far.png", 0.05f, 512.0f},
+    {"textures/parallax-mid.png", 0.25f, 256.0f},
+    {"textures/parallax-near.png", 0.6f, 384.0f},
+};
+
+const char *const PARALLAX_VERTEX_SHADER_PATH = "shaders/parallax.vert";
+const char *const PARALLAX_FRAGMENT_SHADER_PATH = "shaders/parallax.frag";
+
+class ParallaxBackground
+{
+public:
+    // Carrega as camadas e o shader; false (e nada é desenhado) se algum arquivo faltar
+    bool setup(float viewWidth, float viewHeight);
+    void destroy();
+    bool ready() const { return program != 0; }
+
+    // scroll: distância percorrida pelos meteoros, em pixels. Desenha layerCount camadas a partir de
+    // firstLayer (0 = a distante, opaca). Deixa o próprio programa em uso.
+    void draw(double scroll, int firstLayer, int layerCount);
+
+private:
+    GLuint textureArray = 0;
+    GLuint program = 0;
+    GLuint VAO = 0; // vazio: o perfil core exige um VAO ligado mesmo sem atributos
+    GLint scrollLoc = -1;
+    GLint firstLayerLoc = -1;
+};
@@ -0,0 +1,320 @@
+#include "Particles.h"
+#include "Profiler.h"
+#include "SpriteShader.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <string>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define PARTICLES_SSE2 1
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#define PARTICLES_NEON 1
+#endif
+
+// Quatro floats por registrador; as mesmas operações com SSE2 (x86-64) ou NEON (Apple Silicon)
+#if defined(PARTICLES_SSE2)
+typedef __m128 float4;
+static inline float4 load4(const float *p) { return _mm_loadu_ps(p); }
+static inline void store4(float *p, float4 v) { _mm_storeu_ps(p, v); }
+static inline float4 splat4(float x) { return _mm_set1_ps(x); }
+static inline float4 add4(float4 a, float4 b) { return _mm_add_ps(a, b); }
+static inline float4 sub4(float4 a, float4 b) { return _mm_sub_ps(a, b); }
+static inline float4 mul4(float4 a, float4 b) { return _mm_mul_ps(a, b); }
+static inline float4 clamp4(float4 v, float4 lo, float4 hi) { return _mm_min_ps(_mm_max_ps(v, lo), hi); }
+// Quatro canais (0 a 255) em quatro RGBA8: o canal c vai para o byte c de cada cor
+static inline void packColors4(float4 r, float4 g, float4 b, float4 a, uint32_t *out)
+{
+    __m128i rgba = _mm_or_si128(_mm_or_si128(_mm_cvtps_epi32(r), _mm_slli_epi32(_mm_cvtps_epi32(g), 8)),
+                                _mm_or_si128(_mm_slli_epi32(_mm_cvtps_epi32(b), 16), _mm_slli_epi32(_mm_cvtps_epi32(a), 24)));
+    _mm_storeu_si128((__m128i *)out, rgba);
+}
+#elif defined(PARTICLES_NEON)
+typedef float32x4_t float4;
+static inline float4 load4(const float *p) { return vld1q_f32(p); }
+static inline void store4(float *p, float4 v) { vst1q_f32(p, v); }
+static inline float4 splat4(float x) { return vdupq_n_f32(x); }
+static inline float4 add4(float4 a, float4 b) { return vaddq_f32(a, b); }
+static inline float4 sub4(float4 a, float4 b) { return vsubq_f32(a, b); }
+static inline float4 mul4(float4 a, float4 b) { return vmulq_f32(a, b); }
+static inline float4 clamp4(float4 v, float4 lo, float4 hi) { return vminq_f32(vmaxq_f32(v, lo), hi); }
+static inline void packColors4(float4 r, float4 g, float4 b, float4 a, uint32_t *out)
+{
+    uint32x4_t rgba = vorrq_u32(vorrq_u32(vcvtnq_u32_f32(r), vshlq_n_u32(vcvtnq_u32_f32(g), 8)),
+                                vorrq_u32(vshlq_n_u32(vcvtnq_u32_f32(b), 16), vshlq_n_u32(vcvtnq_u32_f32(a), 24)));
+    vst1q_u32(out, rgba);
+}
+#endif
+
+void ParticleSystem::create(size_t capacity)
+{
+    this->capacity = (capacity + 3) & ~(size_t)3;
+    count = 0;
+    // Um bloco só para todos os campos; nada é alocado depois disso
+    storage.assign(this->capacity * FIELD_COUNT, 0.0f);
+    for (int field = 0; field < FIELD_COUNT; field++)
+        fields[field] = storage.data() + field * this->capacity;
+}
+
+void ParticleSystem::chunkRange(int chunk, int chunks, size_t &begin, size_t &end) const
+{
+    size_t padded = (count + 3) & ~(size_t)3;
+    begin = (padded * chunk / chunks) & ~(size_t)3;
+    end = (padded * (chunk + 1) / chunks) & ~(size_t)3;
+    if (chunk == chunks - 1)
+        end = padded;
+}
+
+void ParticleSystem::integrate(size_t begin, size_t end, float dt)
+{
+#if defined(PARTICLES_SSE2) || defined(PARTICLES_NEON)
+    if (useSimd)
+    {
+        integrateSimd(begin, end, dt);
+        return;
+    }
+#endif
+    integrateScalar(begin, end, dt);
+}
+
+void ParticleSystem::integrateScalar(size_t begin, size_t end, float dt)
+{
+    float damping = std::pow(PARTICLE_DRAG, dt);
+    float *px = fields[POS_X], *py = fields[POS_Y], *vx = fields[VEL_X], *vy = fields[VEL_Y], *life = fields[LIFE];
+    for (size_t i = begin; i < end; i++)
+    {
+        px[i] += vx[i] * dt;
+        py[i] += vy[i] * dt;
+        vx[i] *= damping;
+        vy[i] *= damping;
+        life[i] -= dt;
+    }
+    for (int channel = 0; channel < 4; channel++)
+    {
+        float *color = fields[RED + channel];
+        const float *rate = fields[RED_RATE + channel];
+        for (size_t i = begin; i < end; i++)
+            color[i] += rate[i] * dt;
+    }
+}
+
+void ParticleSystem::integrateSimd(size_t begin, size_t end, float dt)
+{
+#if defined(PARTICLES_SSE2) || defined(PARTICLES_NEON)
+    const float4 step = splat4(dt);
+    const float4 damping = splat4(std::pow(PARTICLE_DRAG, dt));
+    float *px = fields[POS_X], *py = fields[POS_Y], *vx = fields[VEL_X], *vy = fields[VEL_Y], *life = fields[LIFE];
+    for (size_t i = begin; i < end; i += 4)
+    {
+        float4 velX = load4(vx + i), velY = load4(vy + i);
+        store4(px + i, add4(load4(px + i), mul4(velX, step)));
+        store4(py + i, add4(load4(py + i), mul4(velY, step)));
+        store4(vx + i, mul4(velX, damping));
+        store4(vy + i, mul4(velY, damping));
+        store4(life + i, sub4(load4(life + i), step));
+    }
+    // Um canal por vez: dois fluxos de leitura e um de escrita por laço
+    for (int channel = 0; channel < 4; channel++)
+    {
+        float *color = fields[RED + channel];
+        const float *rate = fields[RED_RATE + channel];
+        for (size_t i = begin; i < end; i += 4)
+            store4(color + i, add4(load4(color + i), mul4(load4(rate + i), step)));
+    }
+#else
+    integrateScalar(begin, end, dt);
+#endif
+}
+
+void ParticleSystem::compact()
+{
+    PROFILE_ZONE("particleCompact");
+    float *life = fields[LIFE];
+    for (size_t i = 0; i < count;)
+    {
+        if (life[i] > 0.0f)
+        {
+            i++;
+            continue;
+        }
+        // A última viva ocupa o lugar (e é testada na próxima volta)
+        count--;
+        for (int field = 0; field < FIELD_COUNT; field++)
+            fields[field][i] = fields[field][count];
+    }
+}
+
+// xorshift32: rápido e suficiente para espalhar partículas
+float ParticleSystem::random(float min, float max)
+{
+    seed ^= seed << 13;
+    seed ^= seed >> 17;
+    seed ^= seed << 5;
+    return min + (max - min) * (float)(seed >> 8) * (1.0f / 16777216.0f);
+}
+
+void ParticleSystem::emit(const ParticleSpawn &spawn, int amount)
+{
+    if (amount <= 0)
+        return;
+    size_t room = capacity - count;
+    if ((size_t)amount > room)
+    {
+        dropped += amount - room;
+        amount = (int)room;
+    }
+    emitted += amount;
+
+    for (int n = 0; n < amount; n++, count++)
+    {
+        float angle = spawn.angle + random(-0.5f, 0.5f) * spawn.spread;
+        float speed = random(spawn.speedMin, spawn.speedMax);
+        float life = random(spawn.lifeMin, spawn.lifeMax);
+        fields[POS_X][count] = spawn.x + random(-spawn.spreadX, spawn.spreadX);
+        fields[POS_Y][count] = spawn.y + random(-spawn.spreadY, spawn.spreadY);
+        fields[VEL_X][count] = spawn.baseVX + std::cos(angle) * speed;
+        fields[VEL_Y][count] = spawn.baseVY + std::sin(angle) * speed;
+        fields[LIFE][count] = life;
+        fields[SIZE][count] = random(spawn.sizeMin, spawn.sizeMax);
+        // Cor interpolada até endColor no fim da vida: uma taxa constante por canal
+        for (int channel = 0; channel < 4; channel++)
+        {
+            fields[RED + channel][count] = spawn.startColor[channel];
+            fields[RED_RATE + channel][count] = (spawn.endColor[channel] - spawn.startColor[channel]) / life;
+        }
+    }
+    peak = std::max(peak, count);
+}
+
+static inline uint8_t toByte(float value)
+{
+    return (uint8_t)(std::min(std::max(value, 0.0f), 1.0f) * 255.0f + 0.5f);
+}
+
+void ParticleSystem::pack(size_t begin, size_t end, ParticleInstance *out) const
+{
+    end = std::min(end, count);
+    size_t i = begin;
+#if defined(PARTICLES_SSE2) || defined(PARTICLES_NEON)
+    // Cores convertidas de 4 em 4 (as duas arquiteturas são little-endian: o byte 0 é o vermelho)
+    const float4 zero = splat4(0.0f), one = splat4(1.0f), scale = splat4(255.0f);
+    for (; useSimd && i + 4 <= end; i += 4)
+    {
+        float4 alpha = clamp4(load4(fields[ALPHA] + i), zero, one);
+        float4 toByte = mul4(alpha, scale);
+        uint32_t colors[4];
+        packColors4(mul4(clamp4(load4(fields[RED] + i), zero, one), toByte), mul4(clamp4(load4(fields[GREEN] + i), zero, one), toByte),
+                    mul4(clamp4(load4(fields[BLUE] + i), zero, one), toByte), toByte, colors);
+        for (int lane = 0; lane < 4; lane++)
+        {
+            ParticleInstance &instance = out[i + lane];
+            instance.position[0] = fields[POS_X][i + lane];
+            instance.position[1] = fields[POS_Y][i + lane];
+            instance.size = fields[SIZE][i + lane];
+            memcpy(instance.color, &colors[lane], 4);
+        }
+    }
+#endif
+    for (; i < end; i++)
+    {
+        ParticleInstance &instance = out[i];
+        float alpha = std::min(std::max(fields[ALPHA][i], 0.0f), 1.0f);
+        instance.position[0] = fields[POS_X][i];
+        instance.position[1] = fields[POS_Y][i];
+        instance.size = fields[SIZE][i];
+        instance.color[0] = toByte(fields[RED][i] * alpha);
+        instance.color[1] = toByte(fields[GREEN][i] * alpha);
+        instance.color[2] = toByte(fields[BLUE][i] * alpha);
+        instance.color[3] = toByte(alpha);
+    }
+}
+
+const char *ParticleSystem::integrationPath() const
+{
+#if defined(PARTICLES_SSE2)
+    return useSimd ? "SSE2" : "scalar";
+#elif defined(PARTICLES_NEON)
+    return useSimd ? "NEON" : "scalar";
+#else
+    return "scalar";
+#endif
+}
+
+void ParticleSystem::printSummary() const
+{
+    if (!emitted)
+        return;
+    printf("Particles: %s integration, %zu capacity, %zu peak live, %llu emitted", integrationPath(), capacity, peak,
+           (unsigned long long)emitted);
+    if (dropped)
+        printf(", %llu dropped (pool full)", (unsigned long long)dropped);
+    printf("\n");
+}
+
+bool ParticleRenderer::setup(float viewWidth, float viewHeight, bool allowPersistentMapping)
+{
+    std::string vertexSource, fragmentSource, errorLog;
+    if (!readShaderSource(PARTICLE_VERTEX_SHADER_PATH, vertexSource) || !readShaderSource(PARTICLE_FRAGMENT_SHADER_PATH, fragmentSource))
+    {
+        printf("Particles disabled: cannot read %s or %s\n", PARTICLE_VERTEX_SHADER_PATH, PARTICLE_FRAGMENT_SHADER_PATH);
+        return false;
+    }
+    program = compileShaderProgram(vertexSource, fragmentSource, errorLog);
+    if (!program)
+    {
+        printf("Particles disabled: shader failed\n%s\n", errorLog.c_str());
+        return false;
+    }
+    glUseProgram(program);
+    glUniform2f(glGetUniformLocation(program, "viewSize"), viewWidth, viewHeight);
+
+    // Espaço inicial para 4096 partículas por frame; cresce com as explosões
+    instances.create(GL_ARRAY_BUFFER, 4096 * sizeof(ParticleInstance), allowPersistentMapping, "particle instances");
+
+    // O quadrado sai de gl_VertexID: só há atributos por instância
+    glGenVertexArrays(1, &VAO);
+    glBindVertexArray(VAO);
+    for (GLuint location = 0; location <= 1; location++)
+    {
+        glEnableVertexAttribArray(location);
+        glVertexAttribDivisor(location, 1);
+    }
+    glBindVertexArray(0);
+    return true;
+}
+
+void ParticleRenderer::destroy()
+{
+    if (program)
+    {
+        instances.destroy();
+        glDeleteProgram(program);
+    }
+    if (VAO)
+        glDeleteVertexArrays(1, &VAO);
+    program = VAO = 0;
+}
+
+void ParticleRenderer::draw(const std::vector<ParticleInstance> &particles)
+{
+    if (particles.empty())
+        return;
+    PROFILE_ZONE("drawParticles");
+    size_t bytes = particles.size() * sizeof(ParticleInstance);
+    memcpy(instances.map(bytes), particles.data(), bytes);
+    instances.commit(bytes);
+
+    glUseProgram(program);
+    glBindVertexArray(VAO);
+    size_t base = instances.offset();
+    const GLsizei stride = sizeof(ParticleInstance);
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, stride, (GLvoid *)(base + offsetof(ParticleInstance, position)));
+    glVertexAttribPointer(1, 4, GL_UNSIGNED_BYTE, GL_TRUE, stride, (GLvoid *)(base + offsetof(ParticleInstance, color)));
+    glDrawArraysInstanced(GL_TRIANGLE_STRIP, 0, 4, (GLsizei)particles.size());
+    instances.fence();
+}
@@ -0,0 +1,105 @@
+#pragma once
+
+#include "RenderSnapshot.h"
+#include "StreamBuffer.h"
+
+#include <glad/glad.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Parâmetros de uma emissão (velocidades em pixels por tick, vida em ticks da simulação)
+struct ParticleSpawn
+{
+    float x = 0.0f, y = 0.0f;
+    float spreadX = 0.0f, spreadY = 0.0f; // meia largura da área de nascimento
+    float baseVX = 0.0f, baseVY = 0.0f;   // velocidade herdada do emissor
+    float angle = 0.0f, spread = 6.2831853f; // direção central e abertura do leque, em radianos
+    float speedMin = 0.0f, speedMax = 1.0f;
+    float lifeMin = 30.0f, lifeMax = 60.0f;
+    float sizeMin = 2.0f, sizeMax = 3.0f;
+    float startColor[4] = {1.0f, 1.0f, 1.0f, 1.0f}; // RGBA sem pré-multiplicar
+    float endColor[4] = {1.0f, 1.0f, 1.0f, 0.0f};   // cor ao fim da vida (interpolada linearmente)
+};
+
+// Partículas em estrutura de arrays: um vetor contíguo por campo, capacidade fixa e remoção por
+// troca com a última viva. A integração (posição, velocidade, vida e cor) anda de 4 em 4 com
+// SSE2 ou NEON, em faixas independentes que podem ir para tarefas diferentes do grafo; emissão
+// e remoção são seriais. Emissões além da capacidade são descartadas e contadas.
+class ParticleSystem
+{
+public:
+    static const size_t DEFAULT_CAPACITY = 131072;
+
+    // Aloca os campos uma vez (capacidade arredondada para múltiplo de 4)
+    void create(size_t capacity = DEFAULT_CAPACITY);
+    void clear() { count = 0; }
+    size_t size() const { return count; }
+    size_t maxSize() const { return capacity; }
+
+    // Faixa [begin, end) da tarefa chunk; os limites são múltiplos de 4 e podem passar de size()
+    // até o próximo múltiplo (as posições extras são integradas e ignoradas)
+    void chunkRange(int chunk, int chunks, size_t &begin, size_t &end) const;
+    void integrate(size_t begin, size_t end, float dt);
+    // Remove as partículas sem vida
+    void compact();
+    void emit(const ParticleSpawn &spawn, int amount);
+    // Converte a faixa [begin, end) de partículas vivas (limitada a size()) para desenho
+    void pack(size_t begin, size_t end, ParticleInstance *out) const;
+
+    // false força o laço escalar (comparação)
+    bool useSimd = true;
+    // Nome do caminho de integração em uso
+    const char *integrationPath() const;
+    void printSummary() const;
+
+private:
+    enum Field
+    {
+        POS_X, POS_Y, VEL_X, VEL_Y, LIFE, SIZE,
+        RED, GREEN, BLUE, ALPHA,
+        RED_RATE, GREEN_RATE, BLUE_RATE, ALPHA_RATE,
+        FIELD_COUNT
+    };
+
+    void integrateScalar(size_t begin, size_t end, float dt);
+    void integrateSimd(size_t begin, size_t end, float dt);
+    float random(float min, float max);
+
+    std::vector<float> storage;
+    float *fields[FIELD_COUNT] = {};
+    size_t capacity = 0, count = 0;
+    uint32_t seed = 0x9E3779B9u; // gerador próprio: não mexe na sequência do rand() do jogo
+
+    // Estatísticas
+    uint64_t emitted = 0, dropped = 0;
+    size_t peak = 0;
+};
+
+// Redução da velocidade por tick (o espaço do jogo "arrasta" as partículas até pararem)
+const float PARTICLE_DRAG = 0.97f;
+
+const char *const PARTICLE_VERTEX_SHADER_PATH = "shaders/particle.vert";
+const char *const PARTICLE_FRAGMENT_SHADER_PATH = "shaders/particle.frag";
+
+// Desenha FrameSnapshot::particles em um único glDrawArraysInstanced, com os dados copiados para
+// um StreamBuffer próprio. Só deve ser usado na thread dona do contexto.
+class ParticleRenderer
+{
+public:
+    // false (e nada é desenhado) se o shader faltar ou não compilar
+    bool setup(float viewWidth, float viewHeight, bool allowPersistentMapping);
+    void destroy();
+    bool ready() const { return program != 0; }
+
+    // Usa o blending e a profundidade correntes; deixa o próprio programa em uso
+    void draw(const std::vector<ParticleInstance> &particles);
+
+    const StreamBuffer &stream() const { return instances; }
+
+private:
+    GLuint program = 0;
+    GLuint VAO = 0;
+    StreamBuffer instances;
+};
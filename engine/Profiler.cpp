@@ -0,0 +1,94 @@
+#include "Profiler.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <mutex>
+
+static const char *zoneNames[MAX_PROFILE_ZONES] = {"untracked"};
+static std::atomic<int> zoneCount{1};
+static std::mutex zoneMutex;
+
+static ProfileZoneStats frameStats[MAX_PROFILE_ZONES];
+static uint64_t totalNs[MAX_PROFILE_ZONES];
+static uint64_t totalAllocs[MAX_PROFILE_ZONES];
+static uint64_t totalAllocBytes[MAX_PROFILE_ZONES];
+static uint64_t framesClosed = 0;
+
+static thread_local int activeZone = 0;
+
+int profileZoneId(const char *name)
+{
+    std::lock_guard<std::mutex> lock(zoneMutex);
+    int count = zoneCount.load();
+    for (int i = 0; i < count; i++)
+        if (strcmp(zoneNames[i], name) == 0)
+            return i;
+    if (count == MAX_PROFILE_ZONES)
+        return 0;
+    zoneNames[count] = name;
+    zoneCount.store(count + 1);
+    return count;
+}
+
+const char *profileZoneName(int id)
+{
+    return (id >= 0 && id < zoneCount.load()) ? zoneNames[id] : "?";
+}
+
+int profileZoneCount()
+{
+    return zoneCount.load();
+}
+
+int currentProfileZone()
+{
+    return activeZone;
+}
+
+ProfileZoneStats &profileZoneStats(int id)
+{
+    return frameStats[id];
+}
+
+uint64_t profilerNowNs()
+{
+    using namespace std::chrono;
+    return duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count();
+}
+
+ProfileZone::ProfileZone(int id) : id(id), previous(activeZone), start(profilerNowNs())
+{
+    activeZone = id;
+}
+
+ProfileZone::~ProfileZone()
+{
+    frameStats[id].ns.fetch_add(profilerNowNs() - start, std::memory_order_relaxed);
+    activeZone = previous;
+}
+
+void profilerEndFrame()
+{
+    int count = zoneCount.load();
+    for (int i = 0; i < count; i++)
+    {
+        totalNs[i] += frameStats[i].ns.exchange(0, std::memory_order_relaxed);
+        totalAllocs[i] += frameStats[i].allocs.exchange(0, std::memory_order_relaxed);
+        totalAllocBytes[i] += frameStats[i].allocBytes.exchange(0, std::memory_order_relaxed);
+    }
+    framesClosed++;
+}
+
+void profilerPrintSummary()
+{
+    if (framesClosed == 0)
+        return;
+
+    double frames = (double)framesClosed;
+    printf("Profile over %llu frames\n", (unsigned long long)framesClosed);
+    printf("  %-24s %10s %12s %14s\n", "zone", "ms/frame", "allocs/frame", "bytes/frame");
+    for (int i = 0; i < zoneCount.load(); i++)
+        printf("  %-24s %10.3f %12.2f %14.1f\n", zoneNames[i], totalNs[i] / 1e6 / frames, totalAllocs[i] / frames,
+               totalAllocBytes[i] / frames);
+}
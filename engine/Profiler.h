@@ -0,0 +1,51 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+// Zonas de profiling: marcam o trecho do frame em execução para atribuir tempo e alocações.
+// A zona 0 ("untracked") é tudo o que roda fora de uma zona.
+const int MAX_PROFILE_ZONES = 32;
+
+struct ProfileZoneStats
+{
+    std::atomic<uint64_t> ns{0};
+    std::atomic<uint64_t> allocs{0};
+    std::atomic<uint64_t> allocBytes{0};
+};
+
+// Registra a zona (nomes devem ser literais) e retorna seu id; o mesmo nome retorna o mesmo id
+int profileZoneId(const char *name);
+const char *profileZoneName(int id);
+int profileZoneCount();
+
+// Zona ativa da thread atual
+int currentProfileZone();
+
+// Contadores do frame corrente de uma zona (escritos pelas zonas e pelo rastreador de alocações)
+ProfileZoneStats &profileZoneStats(int id);
+
+// Fecha o frame: acumula os contadores no total e zera os do frame
+void profilerEndFrame();
+void profilerPrintSummary();
+
+uint64_t profilerNowNs();
+
+// Entra na zona no construtor e volta para a anterior no destrutor
+class ProfileZone
+{
+public:
+    explicit ProfileZone(int id);
+    ~ProfileZone();
+
+private:
+    int id;
+    int previous;
+    uint64_t start;
+};
+
+#define PROFILE_ZONE_CONCAT2(a, b) a##b
+#define PROFILE_ZONE_CONCAT(a, b) PROFILE_ZONE_CONCAT2(a, b)
+#define PROFILE_ZONE(name)                                                                      \
+    static const int PROFILE_ZONE_CONCAT(profileZoneId_, __LINE__) = profileZoneId(name);       \
+    ProfileZone PROFILE_ZONE_CONCAT(profileZone_, __LINE__)(PROFILE_ZONE_CONCAT(profileZoneId_, __LINE__))
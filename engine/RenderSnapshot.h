@@ -0,0 +1,95 @@
+#pragma once
+
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+
+#include <cstdint>
+#include <vector>
+
+// Camada de depuração (DebugDraw.h) só nos builds de desenvolvimento: com NDEBUG ela sai inteira
+// da compilação, inclusive a lista de vértices do snapshot
+#ifndef NDEBUG
+#define DEBUG_DRAW_ENABLED 1
+#else
+#define DEBUG_DRAW_ENABLED 0
+#endif
+
+// Uma sprite pronta para desenho: tudo o que o renderizador precisa, sem referência ao estado do jogo
+struct SpriteDraw
+{
+    GLuint texID;
+    GLuint VAO;
+    uint16_t vertexCount = 4; // vértices da faixa de triângulos do VAO (4 = quad, até 8 com contorno)
+    glm::vec3 position;
+    glm::vec3 dimensions;
+    glm::vec2 offsetTex; // deslocamento de UV (linha da animação ou frame fixo)
+    bool opaque = false; // textura sem transparência: vai para a passada opaca
+
+    // Animação por tempo, resolvida no vertex shader com o tempo do frame (animFPS 0: parada)
+    float animFPS = 0.0f;
+    float animStart = 0.0f; // segundos (no tempo do frame) em que a animação estava em animFirstFrame
+    uint16_t animFrames = 1, animFirstFrame = 0;
+};
+
+// Uma partícula pronta para desenho (atributos por instância do shader de partículas)
+struct ParticleInstance
+{
+    float position[2];
+    float size;       // lado do quadrado, em pixels
+    uint8_t color[4]; // RGBA com alfa pré-multiplicado
+};
+
+// O que muda de um meteoro para outro no caminho de descarte na GPU (16 bytes por meteoro)
+struct MeteorState
+{
+    float position[2];
+    float animStart; // como SpriteDraw::animStart
+    float animFirstFrame;
+};
+
+// Sprites iguais a prototype em todo o resto, descartadas e compactadas por um compute shader e
+// desenhadas com um glDrawArraysIndirect depois das sprites da lista (ver GpuCulling.h)
+struct GpuSpriteField
+{
+    SpriteDraw prototype;
+    std::vector<MeteorState> instances;
+};
+
+#if DEBUG_DRAW_ENABLED
+// Vértice da camada de depuração (triângulos em pixels da tela, ver DebugDraw.h)
+struct DebugVertex
+{
+    float position[2];
+    uint8_t color[4]; // RGBA sem pré-multiplicar
+};
+#endif
+
+// Estado imutável de um frame, publicado pela simulação e consumido pelo renderizador.
+// Os vetores são reaproveitados entre frames: depois do aquecimento não há alocação.
+struct FrameSnapshot
+{
+    uint32_t frame = 0;
+    float time = 0.0f;               // segundos do frame desde a última época das animações (uniform do shader)
+    double backgroundScroll = 0.0;   // rolagem do fundo em parallax (pixels percorridos pelos meteoros)
+    uint64_t inputTick = 0;          // instante do evento de entrada mais antigo aplicado neste frame (0: nenhum)
+    std::vector<SpriteDraw> sprites; // em ordem de desenho, de trás para frente
+    std::vector<ParticleInstance> particles; // um único desenho, na frente das sprites
+#if DEBUG_DRAW_ENABLED
+    std::vector<DebugVertex> debugVertices;  // camada de depuração, por cima de tudo (vazia se desligada)
+#endif
+    GpuSpriteField gpuMeteors;               // meteoros do caminho da GPU (vazio no caminho da CPU)
+
+    void reset(uint32_t frameIndex)
+    {
+        frame = frameIndex;
+        time = 0.0f;
+        backgroundScroll = 0.0;
+        inputTick = 0;
+        sprites.clear();
+        particles.clear();
+#if DEBUG_DRAW_ENABLED
+        debugVertices.clear();
+#endif
+        gpuMeteors.instances.clear();
+    }
+};
@@ -0,0 +1,110 @@
+#include "RenderThread.h"
+#include "GameClock.h"
+#include "InputQueue.h"
+#include "Profiler.h"
+
+void RenderThread::start(GLFWwindow *window, Renderer *renderer, bool threaded)
+{
+    this->window = window;
+    this->renderer = renderer;
+    isThreaded = threaded;
+    stopping = false;
+
+    if (isThreaded)
+    {
+        glfwMakeContextCurrent(nullptr);
+        thread = std::thread(&RenderThread::run, this);
+    }
+}
+
+void RenderThread::stop()
+{
+    if (!isThreaded || !thread.joinable())
+        return;
+
+    {
+        std::lock_guard<std::mutex> lock(wakeMutex);
+        stopping = true;
+    }
+    wakeRenderer.notify_one();
+    thread.join();
+    glfwMakeContextCurrent(window);
+}
+
+void RenderThread::publish()
+{
+    publishedCount++;
+    if (!isThreaded)
+    {
+        buffer.publish();
+        buffer.acquire();
+        consumedCount = publishedCount;
+        present(buffer.readSlot());
+        return;
+    }
+
+    // Não deixa a simulação passar mais de um frame à frente do renderizador
+    {
+        PROFILE_ZONE("waitRenderer");
+        std::unique_lock<std::mutex> lock(wakeMutex);
+        wakeSimulation.wait(lock, [&] { return consumedCount.load() + 1 >= publishedCount || stopping; });
+    }
+
+    buffer.publish();
+    {
+        std::lock_guard<std::mutex> lock(wakeMutex);
+    }
+    wakeRenderer.notify_one();
+}
+
+void RenderThread::waitPresented(uint64_t count)
+{
+    std::unique_lock<std::mutex> lock(wakeMutex);
+    wakeSimulation.wait(lock, [&] { return presentedCount.load() >= count || !isThreaded; });
+}
+
+void RenderThread::present(const FrameSnapshot &frame)
+{
+    if (reloader)
+        reloader->applyReady(*renderer);
+    renderer->renderFrame(frame);
+    {
+        PROFILE_ZONE("glfwSwapBuffers");
+        glfwSwapBuffers(window);
+    }
+    if (frame.inputTick)
+        inputLatency.record(frame.inputTick, gameClock.read());
+    if (finishFirstFrame && presentedCount == 0)
+        glFinish();
+    presentedCount++;
+}
+
+void RenderThread::run()
+{
+    glfwMakeContextCurrent(window);
+
+    for (;;)
+    {
+        {
+            std::unique_lock<std::mutex> lock(wakeMutex);
+            wakeRenderer.wait(lock, [&] { return stopping.load() || buffer.hasNew(); });
+            if (stopping && !buffer.hasNew())
+                break;
+        }
+
+        buffer.acquire();
+        {
+            std::lock_guard<std::mutex> lock(wakeMutex);
+            consumedCount++;
+        }
+        wakeSimulation.notify_all();
+
+        present(buffer.readSlot());
+        {
+            std::lock_guard<std::mutex> lock(wakeMutex);
+        }
+        wakeSimulation.notify_all();
+    }
+
+    glfwMakeContextCurrent(nullptr);
+}
@@ -0,0 +1,63 @@
+#pragma once
+
+#include "HotReload.h"
+#include "RenderSnapshot.h"
+#include "Renderer.h"
+#include "TripleBuffer.h"
+
+#include <GLFW/glfw3.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+// Thread de renderização: dona do contexto GL, desenha os FrameSnapshot publicados pela
+// simulação através de um buffer triplo. A simulação fica no máximo um frame à frente,
+// então simulação do frame N+1 e desenho do frame N acontecem em paralelo.
+// Com threaded = false tudo roda na thread que publica (útil para depuração e comparação).
+class RenderThread
+{
+public:
+    // O contexto da janela deve estar corrente na thread chamadora; no modo com thread ele é
+    // liberado aqui e passa para a thread de renderização
+    void start(GLFWwindow *window, Renderer *renderer, bool threaded);
+    // Termina a thread e devolve o contexto para a thread chamadora
+    void stop();
+
+    // Slot da simulação para o próximo frame
+    FrameSnapshot &beginFrame() { return buffer.writeSlot(); }
+    // Publica o slot preenchido; espera se o renderizador ainda não pegou o frame anterior
+    void publish();
+
+    // Espera até que `count` frames tenham sido apresentados
+    void waitPresented(uint64_t count);
+    uint64_t published() const { return publishedCount; }
+    uint64_t presented() const { return presentedCount.load(); }
+    bool threaded() const { return isThreaded; }
+
+    // Chama glFinish depois do primeiro frame (medição de inicialização)
+    bool finishFirstFrame = false;
+    // Texturas e shaders recarregados entram antes do desenho de cada frame (--hot-reload)
+    HotReloader *reloader = nullptr;
+
+private:
+    void run();
+    void present(const FrameSnapshot &frame);
+
+    GLFWwindow *window = nullptr;
+    Renderer *renderer = nullptr;
+    bool isThreaded = false;
+
+    TripleBuffer<FrameSnapshot> buffer;
+    uint64_t publishedCount = 0;
+    std::atomic<uint64_t> consumedCount{0};
+    std::atomic<uint64_t> presentedCount{0};
+    std::atomic<bool> stopping{false};
+
+    // Só para dormir/acordar; os dados passam pelo buffer triplo
+    std::mutex wakeMutex;
+    std::condition_variable wakeRenderer;
+    std::condition_variable wakeSimulation;
+    std::thread thread;
+};
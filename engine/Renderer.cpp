@@ -0,0 +1,307 @@
+#include "Renderer.h"
+#include "CommandCapture.h"
+#include "Profiler.h"
+
+#include <glm/gtc/matrix_transform.hpp>
+#include <glm/gtc/type_ptr.hpp>
+
+#include <cstddef>
+#include <cstdio>
+
+// Profundidade da sprite pela posição na lista (0 = mais ao fundo), entre as camadas do parallax
+// (perto de 1 na NDC) e o plano próximo. A projeção ortográfica inverte z: z maior fica na frente.
+static float orderDepth(size_t index, size_t count)
+{
+    return -0.99f + 1.98f * (float)(index + 1) / (float)(count + 1);
+}
+
+void premultiplyAlpha(unsigned char *rgba, int width, int height)
+{
+    size_t pixels = (size_t)width * height;
+    for (size_t i = 0; i < pixels; i++, rgba += 4)
+    {
+        unsigned alpha = rgba[3];
+        rgba[0] = (unsigned char)((rgba[0] * alpha + 127) / 255);
+        rgba[1] = (unsigned char)((rgba[1] * alpha + 127) / 255);
+        rgba[2] = (unsigned char)((rgba[2] * alpha + 127) / 255);
+    }
+}
+
+bool isFullyOpaque(const unsigned char *rgba, int width, int height)
+{
+    size_t pixels = (size_t)width * height;
+    for (size_t i = 0; i < pixels; i++)
+        if (rgba[i * 4 + 3] != 255)
+            return false;
+    return true;
+}
+
+void Renderer::setup(GLuint shaderID, float viewWidth, float viewHeight)
+{
+    this->viewWidth = viewWidth;
+    this->viewHeight = viewHeight;
+    setShader(shaderID);
+
+    // Espaço inicial para 1024 sprites por frame; cresce se o jogo passar disso
+    instances.create(GL_ARRAY_BUFFER, 1024 * sizeof(SpriteInstance), allowPersistentMapping, "sprite instances");
+    background.setup(viewWidth, viewHeight);
+    particles.setup(viewWidth, viewHeight, allowPersistentMapping);
+    if (allowGpuCulling)
+        gpuCull.setup(viewWidth, viewHeight, allowPersistentMapping);
+#if DEBUG_DRAW_ENABLED
+    debugLayer.setup(viewWidth, viewHeight, allowPersistentMapping);
+#endif
+    glUseProgram(shaderID);
+
+    // O viewport corrente é o da janela inteira
+    GLint viewport[4];
+    glGetIntegerv(GL_VIEWPORT, viewport);
+    resolution.setup(resolutionConfig, viewport[2], viewport[3]);
+
+    // Ativando o primeiro buffer de textura da OpenGL
+    glActiveTexture(GL_TEXTURE0);
+
+    // Transparência com alfa pré-multiplicado; o teste de profundidade é ajustado a cada passada
+    glBlendFunc(GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
+    glEnable(GL_DEPTH_TEST);
+
+    // Estado da passada translúcida (o replayer recria as passadas pelo próprio Renderer)
+    captureState(true, GL_ONE, GL_ONE_MINUS_SRC_ALPHA, layeredPasses ? GL_LESS : GL_ALWAYS);
+}
+
+void Renderer::destroy()
+{
+    instances.destroy();
+    background.destroy();
+    particles.destroy();
+    gpuCull.destroy();
+#if DEBUG_DRAW_ENABLED
+    debugLayer.destroy();
+#endif
+    resolution.destroy();
+}
+
+void Renderer::setShader(GLuint shaderID)
+{
+    this->shaderID = shaderID;
+    glUseProgram(shaderID);
+
+    // Os dados de cada sprite vêm dos atributos por instância; só sobram uniforms globais
+    timeLoc = glGetUniformLocation(shaderID, "time");
+    glUniform1i(glGetUniformLocation(shaderID, "texBuffer"), 0);
+
+    // Matriz de projeção ortográfica
+    glm::mat4 projection = glm::ortho(0.0f, viewWidth, 0.0f, viewHeight, -1.0f, 1.0f);
+    glUniformMatrix4fv(glGetUniformLocation(shaderID, "projection"), 1, GL_FALSE, glm::value_ptr(projection));
+}
+
+void Renderer::setTextureOverride(GLuint original, GLuint replacement)
+{
+    if (original >= textureOverrides.size())
+        textureOverrides.resize(original + 1, 0);
+    textureOverrides[original] = replacement;
+}
+
+void Renderer::renderFrame(const FrameSnapshot &frame)
+{
+    PROFILE_ZONE("render");
+    captureFrame(frame);
+
+    if (resolution.enabled())
+        resolution.begin();
+    glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
+    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT | (measureOverdraw ? GL_STENCIL_BUFFER_BIT : 0));
+    if (measureOverdraw)
+    {
+        // Cada fragmento que passa no teste de profundidade soma 1 no stencil do pixel
+        glEnable(GL_STENCIL_TEST);
+        glStencilFunc(GL_ALWAYS, 0, 0xFF);
+        glStencilOp(GL_KEEP, GL_KEEP, GL_INCR);
+    }
+
+    // Meteoros do caminho da GPU: profundidades logo depois das sprites da lista, na ordem do vetor
+    size_t count = frame.sprites.size();
+    size_t gpuMeteorCount = gpuCull.ready() ? frame.gpuMeteors.instances.size() : 0;
+    size_t depthCount = count + gpuMeteorCount;
+    if (gpuMeteorCount)
+        gpuCull.cull(frame.gpuMeteors, orderDepth(count, depthCount), 1.98f / (float)(depthCount + 1));
+
+    // Ordem das instâncias: opacas de frente para trás, depois translúcidas de trás para frente
+    drawOrder.clear();
+    if (layeredPasses)
+        for (size_t i = count; i-- > 0;)
+            if (frame.sprites[i].opaque)
+                drawOrder.push_back((uint32_t)i);
+    size_t opaqueCount = drawOrder.size();
+    for (size_t i = 0; i < count; i++)
+        if (!layeredPasses || !frame.sprites[i].opaque)
+            drawOrder.push_back((uint32_t)i);
+
+    // Dados de todas as sprites do frame, escritos direto na região mapeada
+    if (count)
+    {
+        SpriteInstance *out = (SpriteInstance *)instances.map(count * sizeof(SpriteInstance));
+        for (uint32_t index : drawOrder)
+        {
+            const SpriteDraw &spr = frame.sprites[index];
+            SpriteInstance &instance = *out++;
+            instance.position[0] = spr.position.x;
+            instance.position[1] = spr.position.y;
+            instance.position[2] = orderDepth(index, depthCount);
+            instance.dimensions[0] = spr.dimensions.x;
+            instance.dimensions[1] = spr.dimensions.y;
+            instance.dimensions[2] = spr.dimensions.z;
+            instance.offsetTex[0] = spr.offsetTex.s;
+            instance.offsetTex[1] = spr.offsetTex.t;
+            instance.animation[0] = (float)spr.animFrames;
+            instance.animation[1] = spr.animFPS;
+            instance.animation[2] = spr.animStart;
+            instance.animation[3] = (float)spr.animFirstFrame;
+        }
+        instances.commit(count * sizeof(SpriteInstance));
+    }
+
+    if (layeredPasses)
+    {
+        // Passada opaca: profundidade real, sem blending
+        glDisable(GL_BLEND);
+        glDepthFunc(GL_LESS);
+        glDepthMask(GL_TRUE);
+        glUseProgram(shaderID);
+        glUniform1f(timeLoc, frame.time);
+        drawRange(frame, 0, opaqueCount);
+        if (gpuMeteorCount && frame.gpuMeteors.prototype.opaque)
+            drawGpuMeteors(frame);
+        if (background.ready())
+            background.draw(frame.backgroundScroll, 0, 1);
+
+        // Passada translúcida: rejeitada atrás do que é opaco, sem escrever profundidade
+        glEnable(GL_BLEND);
+        glDepthMask(GL_FALSE);
+        if (background.ready())
+            background.draw(frame.backgroundScroll, 1, PARALLAX_LAYER_COUNT - 1);
+        glUseProgram(shaderID);
+        drawRange(frame, opaqueCount, count);
+        if (gpuMeteorCount && !frame.gpuMeteors.prototype.opaque)
+            drawGpuMeteors(frame);
+        if (particles.ready())
+            particles.draw(frame.particles);
+        glDepthMask(GL_TRUE);
+    }
+    else
+    {
+        // Tudo em ordem e com blending, como antes das passadas
+        glEnable(GL_BLEND);
+        glDepthFunc(GL_ALWAYS);
+        if (background.ready())
+            background.draw(frame.backgroundScroll, 0, PARALLAX_LAYER_COUNT);
+        glUseProgram(shaderID);
+        glUniform1f(timeLoc, frame.time);
+        drawRange(frame, 0, count);
+        if (gpuMeteorCount)
+            drawGpuMeteors(frame);
+        if (particles.ready())
+            particles.draw(frame.particles);
+    }
+    if (count)
+        instances.fence();
+
+    if (measureOverdraw)
+    {
+        if (frame.frame % OVERDRAW_SAMPLE_PERIOD == 0)
+            sampleOverdraw();
+        glDisable(GL_STENCIL_TEST);
+    }
+    if (resolution.enabled())
+        resolution.end();
+#if DEBUG_DRAW_ENABLED
+    // Na resolução da janela: linhas e texto de depuração não são ampliados
+    if (debugLayer.ready())
+        debugLayer.draw(frame.debugVertices);
+#endif
+}
+
+// Um desenho instanciado por sequência de sprites com a mesma textura e geometria
+void Renderer::drawRange(const FrameSnapshot &frame, size_t begin, size_t end)
+{
+    size_t first = begin;
+    for (size_t i = begin + 1; i <= end; i++)
+    {
+        const SpriteDraw &spr = frame.sprites[drawOrder[first]];
+        if (i < end && frame.sprites[drawOrder[i]].texID == spr.texID && frame.sprites[drawOrder[i]].VAO == spr.VAO)
+            continue;
+        drawBatch(spr, first, i - first);
+        first = i;
+    }
+}
+
+void Renderer::drawBatch(const SpriteDraw &spr, size_t first, size_t count)
+{
+    bindSprite(spr);
+    // Atributos por instância apontando para o trecho do lote na região do frame (o GL 3.3 não
+    // tem base instance, então o deslocamento vai no ponteiro)
+    bindInstanceAttributes(instances.buffer(), instances.offset() + first * sizeof(SpriteInstance));
+    glDrawArraysInstanced(GL_TRIANGLE_STRIP, 0, spr.vertexCount, (GLsizei)count);
+}
+
+// Os visíveis e o comando de desenho já estão na GPU; o número de instâncias não volta para a CPU
+void Renderer::drawGpuMeteors(const FrameSnapshot &frame)
+{
+    // O compute shader escreve o SpriteInstance como 12 floats seguidos
+    static_assert(sizeof(SpriteInstance) == 12 * sizeof(float), "layout de instância do descarte na GPU");
+    glUseProgram(shaderID);
+    bindSprite(frame.gpuMeteors.prototype);
+    bindInstanceAttributes(gpuCull.instanceBuffer(), 0);
+    gpuCull.drawIndirect();
+}
+
+void Renderer::bindSprite(const SpriteDraw &spr)
+{
+    GLuint texID = spr.texID < textureOverrides.size() && textureOverrides[spr.texID] ? textureOverrides[spr.texID] : spr.texID;
+    glBindTexture(GL_TEXTURE_2D, texID);
+    glBindVertexArray(spr.VAO);
+}
+
+void Renderer::bindInstanceAttributes(GLuint buffer, size_t base)
+{
+    glBindBuffer(GL_ARRAY_BUFFER, buffer);
+    const GLsizei stride = sizeof(SpriteInstance);
+    glVertexAttribPointer(2, 3, GL_FLOAT, GL_FALSE, stride, (GLvoid *)(base + offsetof(SpriteInstance, position)));
+    glVertexAttribPointer(3, 3, GL_FLOAT, GL_FALSE, stride, (GLvoid *)(base + offsetof(SpriteInstance, dimensions)));
+    glVertexAttribPointer(4, 2, GL_FLOAT, GL_FALSE, stride, (GLvoid *)(base + offsetof(SpriteInstance, offsetTex)));
+    glVertexAttribPointer(5, 4, GL_FLOAT, GL_FALSE, stride, (GLvoid *)(base + offsetof(SpriteInstance, animation)));
+    for (GLuint location = 2; location <= 5; location++)
+    {
+        glEnableVertexAttribArray(location);
+        glVertexAttribDivisor(location, 1);
+    }
+}
+
+void Renderer::sampleOverdraw()
+{
+    PROFILE_ZONE("overdrawReadback");
+    GLint viewport[4];
+    glGetIntegerv(GL_VIEWPORT, viewport);
+    size_t pixels = (size_t)viewport[2] * viewport[3];
+    stencilPixels.resize(pixels);
+    glPixelStorei(GL_PACK_ALIGNMENT, 1);
+    glReadPixels(viewport[0], viewport[1], viewport[2], viewport[3], GL_STENCIL_INDEX, GL_UNSIGNED_BYTE, stencilPixels.data());
+
+    uint64_t fragments = 0;
+    for (uint8_t layers : stencilPixels)
+        fragments += layers;
+    double overdraw = pixels ? (double)fragments / pixels : 0.0;
+    overdrawSum += overdraw;
+    if (overdraw > overdrawMax)
+        overdrawMax = overdraw;
+    overdrawSamples++;
+}
+
+void Renderer::printOverdrawSummary() const
+{
+    if (!overdrawSamples)
+        return;
+    printf("Overdraw (%s): %.2f shaded fragments per pixel on average, %.2f max, over %llu sampled frames\n",
+           layeredPasses ? "opaque + translucent passes" : "single blended pass", overdrawSum / overdrawSamples, overdrawMax,
+           (unsigned long long)overdrawSamples);
+}
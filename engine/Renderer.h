@@ -0,0 +1,107 @@
+#pragma once
+
+#include "DebugDraw.h"
+#include "DynamicResolution.h"
+#include "GpuCulling.h"
+#include "Parallax.h"
+#include "Particles.h"
+#include "RenderSnapshot.h"
+#include "StreamBuffer.h"
+
+#include <cstdint>
+
+// Desenha um FrameSnapshot com o shader de sprites. Só deve ser usado na thread dona do contexto.
+//
+// Os dados de cada sprite (posição, tamanho, UV, animação) são escritos direto no buffer de
+// streaming e viram atributos por instância; sprites seguidas com a mesma textura e geometria
+// saem em um único glDrawArraysInstanced.
+//
+// Camadas: cada sprite recebe uma profundidade pela sua posição na lista. Primeiro vai a passada
+// opaca (sprites opacas de frente para trás e depois a camada distante do fundo), com teste de
+// profundidade real e sem blending; depois a translúcida (camadas de estrelas e sprites com
+// transparência, de trás para frente), com alfa pré-multiplicado e sem escrita de profundidade.
+// Pixels cobertos por algo opaco não são sombreados de novo. As partículas vão por último, em um
+// único desenho instanciado na frente de tudo; a camada de depuração, quando houver, vem depois
+// da ampliação da resolução dinâmica.
+//
+// Com o descarte na GPU ligado (allowGpuCulling e contexto 4.3), os meteoros de frame.gpuMeteors
+// não passam pela lista: um compute shader escolhe os visíveis e eles saem em um desenho indireto,
+// na passada do protótipo e com a profundidade de quem viria depois das sprites da lista.
+class Renderer
+{
+public:
+    // Guarda o shader e configura o estado fixo do contexto (projeção, blending, profundidade)
+    void setup(GLuint shaderID, float viewWidth, float viewHeight);
+    void renderFrame(const FrameSnapshot &frame);
+    // Libera os buffers de streaming, o fundo e as partículas (com o contexto corrente)
+    void destroy();
+
+    // Troca do shader e de texturas entre frames (recarga a quente)
+    void setShader(GLuint shaderID);
+    GLuint shader() const { return shaderID; }
+    // Desenhos com a textura original passam a usar replacement (0 desfaz a troca)
+    void setTextureOverride(GLuint original, GLuint replacement);
+
+    const StreamBuffer &instanceStream() const { return instances; }
+    const StreamBuffer &particleStream() const { return particles.stream(); }
+    const DynamicResolution &dynamicResolution() const { return resolution; }
+    // Descarte dos meteoros na GPU disponível (depois de setup)
+    bool gpuCullingReady() const { return gpuCull.ready(); }
+
+    // false força o mapeamento por frame do GL 3.3 mesmo com glBufferStorage disponível (antes de setup)
+    bool allowPersistentMapping = true;
+    // false desenha tudo em ordem, com blending e sem rejeição por profundidade (comparação)
+    bool layeredPasses = true;
+    // Conta no stencil os fragmentos sombreados por pixel (amostra a cada OVERDRAW_SAMPLE_PERIOD frames)
+    bool measureOverdraw = false;
+    // Cena em um FBO de resolução variável, ampliado para a janela (antes de setup)
+    DynamicResolutionConfig resolutionConfig;
+    // Tenta o descarte dos meteoros na GPU (antes de setup; sem GL 4.3 fica no caminho da CPU)
+    bool allowGpuCulling = false;
+    void printOverdrawSummary() const;
+    void printGpuCullingSummary() const { gpuCull.printSummary(); }
+
+private:
+    // Atributos por instância (locations 2 a 5 do shader de sprites)
+    struct SpriteInstance
+    {
+        float position[3];
+        float dimensions[3];
+        float offsetTex[2];
+        float animation[4]; // nº de frames, frames por segundo, instante inicial, frame inicial
+    };
+
+    static const uint32_t OVERDRAW_SAMPLE_PERIOD = 30;
+
+    void drawRange(const FrameSnapshot &frame, size_t begin, size_t end);
+    void drawBatch(const SpriteDraw &spr, size_t first, size_t count);
+    // Textura e VAO da sprite; atributos por instância a partir de base em buffer
+    void bindSprite(const SpriteDraw &spr);
+    void bindInstanceAttributes(GLuint buffer, size_t base);
+    void drawGpuMeteors(const FrameSnapshot &frame);
+    void sampleOverdraw();
+
+    GLuint shaderID = 0;
+    float viewWidth = 0.0f, viewHeight = 0.0f;
+    std::vector<GLuint> textureOverrides; // indexado pelo id original; 0 = sem troca
+    GLint timeLoc = -1;
+    StreamBuffer instances;
+    ParallaxBackground background;
+    ParticleRenderer particles;
+#if DEBUG_DRAW_ENABLED
+    DebugDrawRenderer debugLayer;
+#endif
+    DynamicResolution resolution;
+    GpuCuller gpuCull;
+    std::vector<uint32_t> drawOrder; // índices em frame.sprites na ordem das instâncias
+
+    // Overdraw medido
+    std::vector<uint8_t> stencilPixels;
+    uint64_t overdrawSamples = 0;
+    double overdrawSum = 0.0, overdrawMax = 0.0;
+};
+
+// Convenção de alfa do Renderer: as texturas são enviadas com as cores já multiplicadas pelo alfa
+void premultiplyAlpha(unsigned char *rgba, int width, int height);
+// true se nenhum pixel tem transparência (a sprite pode ir para a passada opaca)
+bool isFullyOpaque(const unsigned char *rgba, int width, int height);
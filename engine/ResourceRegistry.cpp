@@ -0,0 +1,220 @@
+#include "ResourceRegistry.h"
+#include "AllocTracker.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <map>
+#include <mutex>
+#include <utility>
+
+struct ResourceInfo
+{
+    ResourceKind kind;
+    GLuint id;
+    int width = 0, height = 0;
+    GLenum format = 0;
+    int mipLevels = 0;
+    size_t bytes = 0;
+    std::string tag;
+};
+
+static std::mutex registryMutex;
+static std::map<std::pair<int, GLuint>, ResourceInfo> resources;
+
+static std::pair<int, GLuint> resourceKey(ResourceKind kind, GLuint id)
+{
+    return std::make_pair((int)kind, id);
+}
+
+static int bytesPerPixel(GLenum format)
+{
+    switch (format)
+    {
+    case GL_R8:
+        return 1;
+    case GL_RG8:
+    case GL_R16F:
+        return 2;
+    case GL_RGB8:
+        return 3;
+    case GL_RGBA16F:
+        return 8;
+    case GL_RGBA32F:
+        return 16;
+    default: // GL_RGBA8, GL_DEPTH24_STENCIL8, GL_DEPTH_COMPONENT32F...
+        return 4;
+    }
+}
+
+static const char *formatName(GLenum format)
+{
+    switch (format)
+    {
+    case GL_R8:
+        return "R8";
+    case GL_RG8:
+        return "RG8";
+    case GL_RGB8:
+        return "RGB8";
+    case GL_RGBA8:
+        return "RGBA8";
+    case GL_RGBA16F:
+        return "RGBA16F";
+    case GL_DEPTH24_STENCIL8:
+        return "D24S8";
+    default:
+        return "?";
+    }
+}
+
+static const char *kindName(ResourceKind kind)
+{
+    switch (kind)
+    {
+    case ResourceKind::Texture:
+        return "texture";
+    case ResourceKind::Buffer:
+        return "buffer";
+    default:
+        return "vao";
+    }
+}
+
+int mipLevelCount(int width, int height)
+{
+    int levels = 1;
+    int size = std::max(width, height);
+    while (size > 1)
+    {
+        size /= 2;
+        levels++;
+    }
+    return levels;
+}
+
+size_t textureBytes(int width, int height, GLenum internalFormat, int mipLevels)
+{
+    size_t total = 0;
+    for (int level = 0; level < mipLevels; level++)
+    {
+        total += (size_t)width * height * bytesPerPixel(internalFormat);
+        width = std::max(1, width / 2);
+        height = std::max(1, height / 2);
+    }
+    return total;
+}
+
+void trackTexture(GLuint id, int width, int height, GLenum internalFormat, int mipLevels, const std::string &tag)
+{
+    ResourceInfo info;
+    info.kind = ResourceKind::Texture;
+    info.id = id;
+    info.width = width;
+    info.height = height;
+    info.format = internalFormat;
+    info.mipLevels = mipLevels;
+    info.bytes = textureBytes(width, height, internalFormat, mipLevels);
+    info.tag = tag;
+
+    std::lock_guard<std::mutex> lock(registryMutex);
+    resources[resourceKey(info.kind, id)] = info;
+}
+
+void trackBuffer(GLuint id, size_t bytes, const std::string &tag)
+{
+    ResourceInfo info;
+    info.kind = ResourceKind::Buffer;
+    info.id = id;
+    info.bytes = bytes;
+    info.tag = tag;
+
+    std::lock_guard<std::mutex> lock(registryMutex);
+    resources[resourceKey(info.kind, id)] = info;
+}
+
+void trackVertexArray(GLuint id, const std::string &tag)
+{
+    ResourceInfo info;
+    info.kind = ResourceKind::VertexArray;
+    info.id = id;
+    info.tag = tag;
+
+    std::lock_guard<std::mutex> lock(registryMutex);
+    resources[resourceKey(info.kind, id)] = info;
+}
+
+void resizeTrackedBuffer(GLuint id, size_t bytes)
+{
+    std::lock_guard<std::mutex> lock(registryMutex);
+    auto it = resources.find(resourceKey(ResourceKind::Buffer, id));
+    if (it != resources.end())
+        it->second.bytes = bytes;
+}
+
+void untrack(ResourceKind kind, GLuint id)
+{
+    std::lock_guard<std::mutex> lock(registryMutex);
+    resources.erase(resourceKey(kind, id));
+}
+
+std::string resourceTag(ResourceKind kind, GLuint id)
+{
+    std::lock_guard<std::mutex> lock(registryMutex);
+    auto it = resources.find(resourceKey(kind, id));
+    return it != resources.end() ? it->second.tag : std::string();
+}
+
+size_t trackedGpuBytes()
+{
+    std::lock_guard<std::mutex> lock(registryMutex);
+    size_t total = 0;
+    for (const auto &entry : resources)
+        total += entry.second.bytes;
+    return total;
+}
+
+static void printEntry(const ResourceInfo &r)
+{
+    const double MB = 1024.0 * 1024.0;
+    if (r.kind == ResourceKind::Texture)
+        printf("    %-7s %4u  %5dx%-5d %-7s %2d mips %9.2f MB  %s\n", kindName(r.kind), r.id, r.width, r.height,
+               formatName(r.format), r.mipLevels, r.bytes / MB, r.tag.c_str());
+    else
+        printf("    %-7s %4u  %29s %9.2f MB  %s\n", kindName(r.kind), r.id, "", r.bytes / MB, r.tag.c_str());
+}
+
+void printResourceReport()
+{
+    const double MB = 1024.0 * 1024.0;
+    std::lock_guard<std::mutex> lock(registryMutex);
+
+    size_t totals[3] = {0, 0, 0};
+    int counts[3] = {0, 0, 0};
+    printf("Resource report\n");
+    for (const auto &entry : resources)
+    {
+        const ResourceInfo &r = entry.second;
+        printEntry(r);
+        totals[(int)r.kind] += r.bytes;
+        counts[(int)r.kind]++;
+    }
+    printf("  textures: %d (%.2f MB), buffers: %d (%.2f MB), vertex arrays: %d\n", counts[0], totals[0] / MB, counts[1],
+           totals[1] / MB, counts[2]);
+    printf("  estimated GPU total: %.2f MB\n", (totals[0] + totals[1]) / MB);
+
+    AllocCounters host = allocTotals();
+    printf("  host heap: %llu live allocations, %.2f MB requested since start\n",
+           (unsigned long long)(host.allocs - host.frees), host.bytes / MB);
+}
+
+int printResourceLeaks()
+{
+    std::lock_guard<std::mutex> lock(registryMutex);
+    if (resources.empty())
+        return 0;
+
+    printf("Resource leaks: %zu object(s) never deleted\n", resources.size());
+    for (const auto &entry : resources)
+        printEntry(entry.second);
+    return (int)resources.size();
+}
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <glad/glad.h>
+
+#include <cstddef>
+#include <string>
+
+// Registro de recursos da OpenGL (texturas, buffers, VAOs) com estimativa de memória,
+// para relatórios sob demanda e detecção de vazamentos na saída.
+enum class ResourceKind
+{
+    Texture,
+    Buffer,
+    VertexArray
+};
+
+// Níveis de mipmap de uma cadeia completa e bytes estimados (nível base + mips)
+int mipLevelCount(int width, int height);
+size_t textureBytes(int width, int height, GLenum internalFormat, int mipLevels);
+
+void trackTexture(GLuint id, int width, int height, GLenum internalFormat, int mipLevels, const std::string &tag);
+void trackBuffer(GLuint id, size_t bytes, const std::string &tag);
+void trackVertexArray(GLuint id, const std::string &tag);
+// Atualiza o tamanho de um buffer já registrado (ex.: glBufferData com outro tamanho)
+void resizeTrackedBuffer(GLuint id, size_t bytes);
+void untrack(ResourceKind kind, GLuint id);
+
+// Etiqueta de um recurso registrado ("" se não existir)
+std::string resourceTag(ResourceKind kind, GLuint id);
+
+size_t trackedGpuBytes();
+void printResourceReport();
+// Lista os recursos ainda registrados; retorna quantos vazaram
+int printResourceLeaks();
@@ -0,0 +1,109 @@
+#include "SpriteOutline.h"
+
+#include <algorithm>
+#include <cmath>
+
+void computeSpriteOutline(const unsigned char *rgba, int width, int height, SpriteOutline &outline,
+                          unsigned char alphaThreshold)
+{
+    outline.vertices.clear();
+    outline.area = 1.0f;
+    int frameWidth = width / std::max(outline.columns, 1);
+    int frameHeight = height / std::max(outline.rows, 1);
+    if (!rgba || frameWidth <= 0 || frameHeight <= 0)
+        return;
+
+    // Limites nas oito direções (u, v, u + v e u - v) sobre os cantos dos pixels visíveis, no
+    // espaço do frame. Cada pixel cresce um texel para cada lado: a filtragem linear ainda tira
+    // alfa dele a meio texel de distância, e o contorno não pode cortar essa borda.
+    float minU = 1.0f, maxU = 0.0f, minV = 1.0f, maxV = 0.0f;
+    float minS = 2.0f, maxS = 0.0f, minD = 1.0f, maxD = -1.0f;
+    bool any = false;
+    for (int y = 0; y < height; y++)
+    {
+        const unsigned char *row = rgba + (size_t)y * width * 4;
+        int frameY = y % frameHeight;
+        // Em cada linha de cada frame só o primeiro e o último pixel visível podem ser extremos
+        for (int frameX0 = 0; frameX0 + frameWidth <= width; frameX0 += frameWidth)
+        {
+            int first = -1, last = -1;
+            for (int x = 0; x < frameWidth; x++)
+                if (row[(frameX0 + x) * 4 + 3] > alphaThreshold)
+                {
+                    if (first < 0)
+                        first = x;
+                    last = x;
+                }
+            if (first < 0)
+                continue;
+            any = true;
+            float u0 = (float)(first - 1) / frameWidth, u1 = (float)(last + 2) / frameWidth;
+            // Linhas da imagem vêm de cima para baixo; v cresce para cima
+            float v0 = 1.0f - (float)(frameY + 2) / frameHeight, v1 = 1.0f - (float)(frameY - 1) / frameHeight;
+            minU = std::min(minU, u0);
+            maxU = std::max(maxU, u1);
+            minV = std::min(minV, v0);
+            maxV = std::max(maxV, v1);
+            minS = std::min(minS, u0 + v0);
+            maxS = std::max(maxS, u1 + v1);
+            minD = std::min(minD, u0 - v1);
+            maxD = std::max(maxD, u1 - v0);
+        }
+    }
+    if (!any)
+        return;
+
+    // Dentro do frame; as diagonais não podem passar dos cantos da caixa já recortada
+    minU = std::max(minU, 0.0f);
+    maxU = std::min(maxU, 1.0f);
+    minV = std::max(minV, 0.0f);
+    maxV = std::min(maxV, 1.0f);
+    minS = std::max(minS, minU + minV);
+    maxS = std::min(maxS, maxU + maxV);
+    minD = std::max(minD, minU - maxV);
+    maxD = std::min(maxD, maxU - minV);
+
+    // Octógono em sentido anti-horário a partir da base: cada vértice cruza um lado reto e uma diagonal
+    const glm::vec2 corners[8] = {
+        {minS - minV, minV}, {maxD + minV, minV}, {maxU, maxU - maxD}, {maxU, maxS - maxU},
+        {maxS - maxV, maxV}, {minD + maxV, maxV}, {minU, minU - minD}, {minU, minS - minU},
+    };
+    const float epsilon = 1e-5f;
+    for (const glm::vec2 &corner : corners)
+        if (outline.vertices.empty() || glm::length(corner - outline.vertices.back()) > epsilon)
+            outline.vertices.push_back(corner);
+    while (outline.vertices.size() > 1 && glm::length(outline.vertices.front() - outline.vertices.back()) <= epsilon)
+        outline.vertices.pop_back();
+
+    float area = 0.0f;
+    for (size_t i = 0; i < outline.vertices.size(); i++)
+    {
+        const glm::vec2 &a = outline.vertices[i];
+        const glm::vec2 &b = outline.vertices[(i + 1) % outline.vertices.size()];
+        area += a.x * b.y - b.x * a.y;
+    }
+    outline.area = 0.5f * area;
+
+    // Sem ganho (ou algo degenerado): fica o quad
+    if (outline.vertices.size() < 3 || outline.area >= 1.0f - epsilon)
+    {
+        outline.vertices.clear();
+        outline.area = 1.0f;
+    }
+}
+
+std::vector<glm::vec2> outlineStripOrder(const std::vector<glm::vec2> &polygon)
+{
+    // p0, p1, pn-1, p2, pn-2, ...: cada triângulo novo fecha uma fatia do polígono convexo
+    std::vector<glm::vec2> strip;
+    strip.reserve(polygon.size());
+    size_t low = 0, high = polygon.size();
+    bool fromLow = true;
+    while (low < high)
+    {
+        strip.push_back(fromLow ? polygon[low++] : polygon[--high]);
+        // Os dois primeiros vêm da mesma ponta
+        fromLow = strip.size() == 1 ? true : !fromLow;
+    }
+    return strip;
+}
@@ -0,0 +1,32 @@
+#pragma once
+
+#include <glm/glm.hpp>
+
+#include <vector>
+
+// Contorno das sprites: em vez do quad inteiro, um polígono convexo justo em volta dos pixels
+// visíveis, para que as regiões transparentes das folhas não sejam rasterizadas, amostradas e
+// misturadas à toa.
+//
+// O polígono é o octógono de lados fixos (horizontais, verticais e diagonais de 45°) que cobre
+// todos os pixels com alfa de todos os frames da folha. A união é necessária porque o frame da
+// animação é escolhido no vertex shader e todas as instâncias de um lote dividem a geometria; o
+// octógono fica dentro do frame, então nunca amostra o vizinho. Cantos que não cortam nada se
+// fundem, e o resultado tem de 4 a 8 vértices.
+struct SpriteOutline
+{
+    // Grade de frames da folha (colunas = frames, linhas = animações), preenchida por quem pede
+    int columns = 1, rows = 1;
+
+    // Vértices em sentido anti-horário, em coordenadas do frame (0 a 1, v = 0 embaixo); vazio = quad
+    std::vector<glm::vec2> vertices;
+    float area = 1.0f; // fração da área do quad coberta pelo polígono
+};
+
+// Calcula o contorno a partir da imagem RGBA (linhas de cima para baixo, como vem do stb_image).
+// Pixels com alfa até alphaThreshold contam como transparentes.
+void computeSpriteOutline(const unsigned char *rgba, int width, int height, SpriteOutline &outline,
+                          unsigned char alphaThreshold = 0);
+
+// Ordem de faixa de triângulos (zigue-zague entre as duas metades) de um polígono convexo
+std::vector<glm::vec2> outlineStripOrder(const std::vector<glm::vec2> &polygon);
@@ -0,0 +1,106 @@
+#include "SpriteShader.h"
+
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+bool readShaderSource(const char *path, std::string &source)
+{
+    std::ifstream file(path, std::ios::binary);
+    if (!file)
+        return false;
+    std::stringstream buffer;
+    buffer << file.rdbuf();
+    source = buffer.str();
+    return true;
+}
+
+// Compila um estágio; em caso de erro acrescenta o log do driver em errorLog
+static GLuint compileStage(GLenum type, const std::string &source, const char *name, std::string &errorLog)
+{
+    GLuint shader = glCreateShader(type);
+    const GLchar *text = source.c_str();
+    glShaderSource(shader, 1, &text, nullptr);
+    glCompileShader(shader);
+
+    GLint ok = GL_FALSE;
+    glGetShaderiv(shader, GL_COMPILE_STATUS, &ok);
+    if (!ok)
+    {
+        char info[1024];
+        glGetShaderInfoLog(shader, sizeof(info), nullptr, info);
+        errorLog += std::string(name) + ": " + info;
+    }
+    return shader;
+}
+
+GLuint compileShaderProgram(const std::string &vertexSource, const std::string &fragmentSource, std::string &errorLog)
+{
+    // Compilando Vertex Shader e Fragment Shader
+    GLuint vertexShader = compileStage(GL_VERTEX_SHADER, vertexSource, "vertex shader", errorLog);
+    GLuint fragmentShader = compileStage(GL_FRAGMENT_SHADER, fragmentSource, "fragment shader", errorLog);
+
+    // Criando o shader program
+    GLuint shaderProgram = glCreateProgram();
+    glAttachShader(shaderProgram, vertexShader);
+    glAttachShader(shaderProgram, fragmentShader);
+    glLinkProgram(shaderProgram);
+
+    // Removendo os shaders após a vinculação
+    glDeleteShader(vertexShader);
+    glDeleteShader(fragmentShader);
+
+    GLint linked = GL_FALSE;
+    glGetProgramiv(shaderProgram, GL_LINK_STATUS, &linked);
+    if (!linked || !errorLog.empty())
+    {
+        char info[1024];
+        glGetProgramInfoLog(shaderProgram, sizeof(info), nullptr, info);
+        errorLog += std::string("link: ") + info;
+        glDeleteProgram(shaderProgram);
+        return 0;
+    }
+    return shaderProgram;
+}
+
+// O glad do projeto só conhece o GL 3.3; o valor do enum vem da especificação 4.3
+#ifndef GL_COMPUTE_SHADER
+#define GL_COMPUTE_SHADER 0x91B9
+#endif
+
+GLuint compileComputeProgram(const std::string &source, std::string &errorLog)
+{
+    GLuint computeShader = compileStage(GL_COMPUTE_SHADER, source, "compute shader", errorLog);
+    GLuint program = glCreateProgram();
+    glAttachShader(program, computeShader);
+    glLinkProgram(program);
+    glDeleteShader(computeShader);
+
+    GLint linked = GL_FALSE;
+    glGetProgramiv(program, GL_LINK_STATUS, &linked);
+    if (!linked || !errorLog.empty())
+    {
+        char info[1024];
+        glGetProgramInfoLog(program, sizeof(info), nullptr, info);
+        errorLog += std::string("link: ") + info;
+        glDeleteProgram(program);
+        return 0;
+    }
+    return program;
+}
+
+// Função de configuração do shader
+GLuint setupShader()
+{
+    std::string vertexSource, fragmentSource, errorLog;
+    if (!readShaderSource(SPRITE_VERTEX_SHADER_PATH, vertexSource) || !readShaderSource(SPRITE_FRAGMENT_SHADER_PATH, fragmentSource))
+    {
+        std::cout << "Cannot read " << SPRITE_VERTEX_SHADER_PATH << " / " << SPRITE_FRAGMENT_SHADER_PATH << std::endl;
+        return 0;
+    }
+
+    GLuint shaderProgram = compileShaderProgram(vertexSource, fragmentSource, errorLog);
+    if (!shaderProgram)
+        std::cout << "Sprite shader failed to build:\n" << errorLog << std::endl;
+    return shaderProgram;
+}
@@ -0,0 +1,19 @@
+#pragma once
+
+#include <glad/glad.h>
+
+#include <string>
+
+// Fontes GLSL do shader das sprites (lidas de arquivo para permitir a recarga a quente)
+const char *const SPRITE_VERTEX_SHADER_PATH = "shaders/sprite.vert";
+const char *const SPRITE_FRAGMENT_SHADER_PATH = "shaders/sprite.frag";
+
+// Compila e vincula o shader das sprites (usado pelo jogo e pelo replayer de traces); 0 se falhar
+GLuint setupShader();
+
+// Lê um arquivo de texto inteiro; false se não existir
+bool readShaderSource(const char *path, std::string &source);
+// Compila e vincula um programa; se falhar retorna 0 e preenche errorLog
+GLuint compileShaderProgram(const std::string &vertexSource, const std::string &fragmentSource, std::string &errorLog);
+// Programa só com compute shader (contexto 4.3); 0 e errorLog preenchido se falhar
+GLuint compileComputeProgram(const std::string &source, std::string &errorLog);
@@ -0,0 +1,73 @@
+#include "StartupTrace.h"
+#include "Benchmark.h"
+
+#include <cstdio>
+
+StartupTrace startupTrace;
+
+void StartupTrace::begin()
+{
+    origin = monotonicSeconds();
+    phases.clear();
+    assets.clear();
+    milestones.clear();
+}
+
+double StartupTrace::nowMs() const
+{
+    return (monotonicSeconds() - origin) * 1000.0;
+}
+
+void StartupTrace::phase(const std::string &name, double startMs)
+{
+    Entry e;
+    e.name = name;
+    e.ms = nowMs() - startMs;
+    phases.push_back(e);
+}
+
+void StartupTrace::asset(const std::string &path, double decodeMs, double uploadMs, size_t fileBytes, size_t decodedBytes)
+{
+    Entry e;
+    e.name = path;
+    e.ms = decodeMs;
+    e.uploadMs = uploadMs;
+    e.fileBytes = fileBytes;
+    e.decodedBytes = decodedBytes;
+    assets.push_back(e);
+}
+
+void StartupTrace::milestone(const std::string &name)
+{
+    Entry e;
+    e.name = name;
+    e.ms = nowMs();
+    milestones.push_back(e);
+}
+
+void StartupTrace::print() const
+{
+    const double MB = 1024.0 * 1024.0;
+
+    printf("Startup report%s\n", precise ? "" : " (uploads not synchronized)");
+    printf("  phases\n");
+    for (const Entry &e : phases)
+        printf("    %-36s %9.1f ms\n", e.name.c_str(), e.ms);
+
+    double decodeTotal = 0.0, uploadTotal = 0.0;
+    size_t fileTotal = 0, decodedTotal = 0;
+    printf("  assets%32s %9s %9s %9s %10s\n", "", "decode ms", "upload ms", "file MB", "decoded MB");
+    for (const Entry &e : assets)
+    {
+        printf("    %-36s %9.1f %9.1f %9.2f %10.2f\n", e.name.c_str(), e.ms, e.uploadMs, e.fileBytes / MB, e.decodedBytes / MB);
+        decodeTotal += e.ms;
+        uploadTotal += e.uploadMs;
+        fileTotal += e.fileBytes;
+        decodedTotal += e.decodedBytes;
+    }
+    printf("    %-36s %9.1f %9.1f %9.2f %10.2f\n", "total", decodeTotal, uploadTotal, fileTotal / MB, decodedTotal / MB);
+
+    printf("  milestones (since main)\n");
+    for (const Entry &e : milestones)
+        printf("    %-36s %9.1f ms\n", e.name.c_str(), e.ms);
+}
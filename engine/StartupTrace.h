@@ -0,0 +1,42 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+// Medição do tempo de inicialização, de main() até o primeiro frame apresentado
+class StartupTrace
+{
+public:
+    // Se verdadeiro, quem mede uploads deve chamar glFinish para atribuir o custo ao asset certo
+    bool precise = false;
+
+    void begin();
+    double nowMs() const;
+
+    // Fase sequencial (ex.: glfwInit): duração de startMs até agora
+    void phase(const std::string &name, double startMs);
+    // Decodificação e upload de um asset, com tamanhos em bytes
+    void asset(const std::string &path, double decodeMs, double uploadMs, size_t fileBytes, size_t decodedBytes);
+    // Marco absoluto desde begin() (ex.: janela criada, primeiro frame)
+    void milestone(const std::string &name);
+
+    void print() const;
+
+private:
+    struct Entry
+    {
+        std::string name;
+        double ms = 0.0;
+        double uploadMs = 0.0;
+        size_t fileBytes = 0;
+        size_t decodedBytes = 0;
+    };
+
+    double origin = 0.0;
+    std::vector<Entry> phases;
+    std::vector<Entry> assets;
+    std::vector<Entry> milestones;
+};
+
+extern StartupTrace startupTrace;
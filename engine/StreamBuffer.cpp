@@ -0,0 +1,150 @@
+#include "StreamBuffer.h"
+#include "Benchmark.h"
+#include "Profiler.h"
+#include "ResourceRegistry.h"
+
+#include <GLFW/glfw3.h>
+
+#include <cstdio>
+
+// glBufferStorage é do GL 4.4; o loader do projeto só cobre o 3.3, então o ponteiro vem do GLFW
+#ifndef GL_MAP_PERSISTENT_BIT
+#define GL_MAP_PERSISTENT_BIT 0x0040
+#define GL_MAP_COHERENT_BIT 0x0080
+#endif
+typedef void(APIENTRYP BufferStorageProc)(GLenum target, GLsizeiptr size, const void *data, GLbitfield flags);
+static BufferStorageProc bufferStorage = nullptr;
+
+void StreamBuffer::create(GLenum target, size_t regionBytes, bool allowPersistent, const std::string &tag)
+{
+    this->target = target;
+    this->tag = tag;
+    bool supported = GLVersion.major > 4 || (GLVersion.major == 4 && GLVersion.minor >= 4) ||
+                     glfwExtensionSupported("GL_ARB_buffer_storage");
+    if (allowPersistent && supported && !bufferStorage)
+        bufferStorage = (BufferStorageProc)glfwGetProcAddress("glBufferStorage");
+    canPersist = allowPersistent && supported && bufferStorage;
+    allocate(regionBytes);
+}
+
+void StreamBuffer::destroy()
+{
+    release();
+}
+
+void StreamBuffer::allocate(size_t regionBytes)
+{
+    regionSize = regionBytes;
+    current = 0;
+    size_t total = regionSize * REGIONS;
+
+    glGenBuffers(1, &bufferID);
+    glBindBuffer(target, bufferID);
+    persistentMapping = false;
+    if (canPersist)
+    {
+        const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+        bufferStorage(target, (GLsizeiptr)total, nullptr, flags);
+        mapped = (unsigned char *)glMapBufferRange(target, 0, (GLsizeiptr)total, flags);
+        persistentMapping = mapped != nullptr;
+        if (!persistentMapping)
+        {
+            // Storage imutável não aceita glBufferData: recomeça com um buffer comum
+            glDeleteBuffers(1, &bufferID);
+            glGenBuffers(1, &bufferID);
+            glBindBuffer(target, bufferID);
+            canPersist = false;
+        }
+    }
+    if (!persistentMapping)
+        glBufferData(target, (GLsizeiptr)total, nullptr, GL_STREAM_DRAW);
+    trackBuffer(bufferID, total, tag);
+}
+
+void StreamBuffer::release()
+{
+    for (GLsync &sync : fences)
+    {
+        if (sync)
+            glDeleteSync(sync);
+        sync = nullptr;
+    }
+    if (!bufferID)
+        return;
+    if (mapped)
+    {
+        glBindBuffer(target, bufferID);
+        glUnmapBuffer(target);
+        mapped = nullptr;
+    }
+    glDeleteBuffers(1, &bufferID);
+    untrack(ResourceKind::Buffer, bufferID);
+    bufferID = 0;
+}
+
+void *StreamBuffer::map(size_t bytes)
+{
+    // Mais dados do que cabem: troca por um buffer maior (o antigo vive até a GPU terminar com ele)
+    if (bytes > regionSize)
+    {
+        size_t grown = regionSize;
+        while (grown < bytes)
+            grown *= 2;
+        release();
+        allocate(grown);
+        grows++;
+    }
+
+    GLsync &sync = fences[current];
+    if (sync)
+    {
+        if (glClientWaitSync(sync, 0, 0) == GL_TIMEOUT_EXPIRED)
+        {
+            PROFILE_ZONE("waitStreamFence");
+            double start = monotonicSeconds();
+            GLenum result;
+            do
+                result = glClientWaitSync(sync, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000);
+            while (result == GL_TIMEOUT_EXPIRED);
+            stalls++;
+            stallSeconds += monotonicSeconds() - start;
+        }
+        glDeleteSync(sync);
+        sync = nullptr;
+    }
+
+    glBindBuffer(target, bufferID);
+    if (persistentMapping)
+        return mapped + offset();
+    // A região já foi liberada pelo fence: mapeia sem sincronizar e sem preservar o conteúdo
+    const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_UNSYNCHRONIZED_BIT | GL_MAP_INVALIDATE_RANGE_BIT | GL_MAP_FLUSH_EXPLICIT_BIT;
+    return glMapBufferRange(target, (GLintptr)offset(), (GLsizeiptr)bytes, flags);
+}
+
+void StreamBuffer::commit(size_t bytesWritten)
+{
+    glBindBuffer(target, bufferID);
+    // Mapeamento coerente: as escritas já são visíveis para os comandos seguintes
+    if (persistentMapping)
+        return;
+    if (bytesWritten)
+        glFlushMappedBufferRange(target, 0, (GLsizeiptr)bytesWritten);
+    glUnmapBuffer(target);
+}
+
+void StreamBuffer::fence()
+{
+    fences[current] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    current = (current + 1) % REGIONS;
+    regionsUsed++;
+}
+
+void StreamBuffer::printSummary() const
+{
+    printf("Stream buffer (%s): %s, %d x %zu KB, %llu regions written, %llu fence stalls (%.2f ms)", tag.c_str(),
+           persistentMapping ? "persistent coherent mapping" : "unsynchronized glMapBufferRange", REGIONS, regionSize / 1024,
+           (unsigned long long)regionsUsed, (unsigned long long)stalls, stallSeconds * 1000.0);
+    if (grows)
+        printf(", grew %d time(s)", grows);
+    printf("\n");
+}
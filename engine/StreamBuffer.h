@@ -0,0 +1,60 @@
+#pragma once
+
+#include <glad/glad.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// Buffer de streaming para dados por frame (instâncias das sprites), dividido em REGIONS
+// regiões usadas em rodízio. Cada região recebe um fence depois dos desenhos que a leem, e só é
+// reescrita quando esse fence sinalizou: a CPU nunca escreve em memória que a GPU ainda lê, e
+// não há órfãos de glBufferData nem cópias do driver.
+//
+// Com GL 4.4 / ARB_buffer_storage o buffer é mapeado uma única vez (persistente e coerente) e a
+// CPU escreve direto nele. Nos contextos 3.3 sem a extensão, cada região é mapeada com
+// glMapBufferRange sem sincronização (os fences já garantem que a GPU terminou com ela).
+// Só deve ser usado na thread dona do contexto.
+class StreamBuffer
+{
+public:
+    static const int REGIONS = 3;
+
+    // allowPersistent = false força o caminho do GL 3.3 (comparação)
+    void create(GLenum target, size_t regionBytes, bool allowPersistent, const std::string &tag);
+    void destroy();
+
+    // Região da vez com pelo menos `bytes` livres para escrita; espera o fence dela se preciso.
+    // O ponteiro vale até commit().
+    void *map(size_t bytes);
+    // Termina a escrita (bytesWritten <= bytes do map); o buffer fica ligado em target
+    void commit(size_t bytesWritten);
+    // Depois dos desenhos que leem a região: coloca o fence e passa para a próxima
+    void fence();
+
+    GLuint buffer() const { return bufferID; }
+    // Deslocamento, em bytes, da região mapeada dentro do buffer
+    size_t offset() const { return (size_t)current * regionSize; }
+    bool persistent() const { return persistentMapping; }
+
+    void printSummary() const;
+
+private:
+    void allocate(size_t regionBytes);
+    void release();
+
+    GLenum target = GL_ARRAY_BUFFER;
+    GLuint bufferID = 0;
+    size_t regionSize = 0;
+    int current = 0;
+    GLsync fences[REGIONS] = {};
+    unsigned char *mapped = nullptr; // mapeamento persistente (nullptr no caminho 3.3)
+    bool canPersist = false, persistentMapping = false;
+    std::string tag;
+
+    // Estatísticas
+    uint64_t regionsUsed = 0;
+    uint64_t stalls = 0; // vezes em que a região ainda estava em uso pela GPU
+    double stallSeconds = 0.0;
+    int grows = 0;
+};
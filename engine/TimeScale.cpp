@@ -0,0 +1,50 @@
+#include "TimeScale.h"
+
+#include <cstdio>
+
+void SimStepper::setup(const TimeScaleConfig &config, double wallNow)
+{
+    this->config = config;
+    wallStart = lastWall = wallNow;
+    owed = 0.0;
+    tickCount = presentedFrames = 0;
+}
+
+int SimStepper::ticksDue(double wallNow)
+{
+    if (unlimited())
+        return UNLIMITED_BATCH;
+
+    owed += (wallNow - lastWall) * config.scale * config.tickRate;
+    lastWall = wallNow;
+
+    // Se a simulação não acompanha a escala pedida, não acumula dívida: a vazão real sai no resumo
+    double maxOwed = 0.25 * config.scale * config.tickRate + 1.0;
+    if (owed > maxOwed)
+        owed = maxOwed;
+
+    int due = (int)owed;
+    owed -= due;
+    return due;
+}
+
+double SimStepper::secondsUntilNextTick() const
+{
+    if (unlimited())
+        return 0.0;
+    return (1.0 - owed) / (config.scale * config.tickRate);
+}
+
+void SimStepper::printSummary(double wallNow) const
+{
+    double wall = wallNow - wallStart;
+    if (wall <= 0.0)
+        return;
+    printf("Time scale ");
+    if (unlimited())
+        printf("max");
+    else
+        printf("%.2fx", config.scale);
+    printf(": simulated %.1f s in %.1f s wall = %.2f sim s / wall s (%llu ticks, %llu presented frames)\n",
+           simSeconds(), wall, simSeconds() / wall, (unsigned long long)tickCount, (unsigned long long)presentedFrames);
+}
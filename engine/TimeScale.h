@@ -0,0 +1,47 @@
+#pragma once
+
+#include <cstdint>
+
+// Escala de tempo da simulação: câmera lenta (< 1), avanço rápido (> 1) e testes de resistência.
+// O jogo move tudo por tick (não por segundo), então a escala muda quantos ticks rodam por frame
+// apresentado; o GameClock passa a avançar um passo fixo por tick em vez de ler o relógio real.
+struct TimeScaleConfig
+{
+    double scale = 1.0;       // segundos simulados por segundo real; 0 = o mais rápido possível
+    bool render = true;       // false: só simula, sem desenhar nem apresentar
+    double soakSeconds = 0.0; // > 0: piloto automático até simular esse tempo, depois sai
+    int tickRate = 60;        // ticks por segundo simulado
+
+    // Fora do padrão (tempo real, um tick por frame)?
+    bool enabled() const { return scale != 1.0 || !render || soakSeconds > 0.0; }
+};
+
+// Decide quantos ticks da simulação rodar a cada frame e mede a vazão (segundos simulados por
+// segundo real)
+class SimStepper
+{
+public:
+    void setup(const TimeScaleConfig &config, double wallNow);
+
+    // Ticks devidos até wallNow; com escala ilimitada, o tamanho do lote seguinte
+    int ticksDue(double wallNow);
+    // Segundos reais até o próximo tick ficar devido (para dormir em câmera lenta)
+    double secondsUntilNextTick() const;
+    void ticksRan(int count) { tickCount += (uint64_t)count; }
+    void framePresented() { presentedFrames++; }
+
+    bool unlimited() const { return config.scale <= 0.0; }
+    double simSeconds() const { return (double)tickCount / config.tickRate; }
+    bool soakDone() const { return config.soakSeconds > 0.0 && simSeconds() >= config.soakSeconds; }
+    void printSummary(double wallNow) const;
+
+    // Lote de ticks por volta do loop sem limite de escala
+    static const int UNLIMITED_BATCH = 256;
+
+private:
+    TimeScaleConfig config;
+    double wallStart = 0.0, lastWall = 0.0;
+    double owed = 0.0; // ticks devidos ainda não rodados (fração incluída)
+    uint64_t tickCount = 0;
+    uint64_t presentedFrames = 0;
+};
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+// Buffer triplo sem locks, com um escritor e um leitor.
+// O escritor preenche writeSlot() e chama publish(); o leitor chama acquire() e lê readSlot().
+// Nenhum dos lados bloqueia: o escritor sempre tem um slot livre e o leitor sempre vê o último
+// slot publicado por inteiro.
+template <typename T>
+class TripleBuffer
+{
+public:
+    T &writeSlot() { return slots[back]; }
+    const T &readSlot() const { return slots[front]; }
+
+    // Troca o slot escrito pelo do meio, marcando-o como novo
+    void publish()
+    {
+        back = middle.exchange(back | FRESH, std::memory_order_acq_rel) & INDEX;
+    }
+
+    bool hasNew() const
+    {
+        return (middle.load(std::memory_order_acquire) & FRESH) != 0;
+    }
+
+    // Se houver um slot novo, passa a lê-lo; retorna false se não houve publicação desde a última leitura
+    bool acquire()
+    {
+        if (!hasNew())
+            return false;
+        front = middle.exchange(front, std::memory_order_acq_rel) & INDEX;
+        return true;
+    }
+
+    // Acesso direto aos três slots (ex.: reservar capacidade antes de começar)
+    T &slot(int i) { return slots[i]; }
+
+private:
+    static const uint8_t INDEX = 0x3;
+    static const uint8_t FRESH = 0x4;
+
+    T slots[3];
+    uint8_t back = 0;
+    std::atomic<uint8_t> middle{1};
+    uint8_t front = 2;
+};
@@ -0,0 +1,89 @@
+#include "ViewCulling.h"
+#include "Profiler.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+
+void CullGrid::setup(const CullRect &area, float cellSize)
+{
+    this->area = area;
+    cell = cellSize;
+    cols = std::max(1, (int)std::ceil((area.max.x - area.min.x) / cellSize));
+    rows = std::max(1, (int)std::ceil((area.max.y - area.min.y) / cellSize));
+    cellStart.assign((size_t)cols * rows + 1, 0);
+}
+
+uint32_t CullGrid::cellOf(glm::vec2 point) const
+{
+    int col = std::min(std::max((int)std::floor((point.x - area.min.x) / cell), 0), cols - 1);
+    int row = std::min(std::max((int)std::floor((point.y - area.min.y) / cell), 0), rows - 1);
+    return (uint32_t)(row * cols + col);
+}
+
+CullRect CullGrid::cellRect(uint32_t index) const
+{
+    glm::vec2 corner = area.min + glm::vec2((float)(index % cols), (float)(index / cols)) * cell;
+    return {corner, corner + glm::vec2(cell)};
+}
+
+void CullGrid::build(const std::vector<uint32_t> &cellOfSprite)
+{
+    PROFILE_ZONE("cullGridBuild");
+    // Contagem por célula e soma acumulada: cellStart[c] passa a ser o fim da célula c
+    std::fill(cellStart.begin(), cellStart.end(), 0);
+    for (uint32_t c : cellOfSprite)
+        cellStart[c]++;
+    uint32_t total = 0;
+    for (uint32_t &start : cellStart)
+    {
+        total += start;
+        start = total;
+    }
+    // De trás para frente, cada célula recua até o próprio início e mantém a ordem dos índices
+    entries.resize(cellOfSprite.size());
+    for (size_t i = cellOfSprite.size(); i-- > 0;)
+        entries[--cellStart[cellOfSprite[i]]] = (uint32_t)i;
+}
+
+size_t CullGrid::cull(const CullRect &view, glm::vec2 halfExtent, std::vector<uint8_t> &visible,
+                      const std::function<bool(uint32_t)> &touchesView) const
+{
+    PROFILE_ZONE("cullGrid");
+    visible.assign(entries.size(), 0);
+    // Centros fora deste retângulo não alcançam a vista
+    CullRect reach = {view.min - halfExtent, view.max + halfExtent};
+    size_t visibleCount = 0;
+    for (int row = 0; row < rows; row++)
+        for (int col = 0; col < cols; col++)
+        {
+            uint32_t index = (uint32_t)(row * cols + col);
+            uint32_t begin = cellStart[index], end = cellStart[index + 1];
+            if (begin == end)
+                continue;
+            bool border = row == 0 || col == 0 || row == rows - 1 || col == cols - 1;
+            CullRect rect = cellRect(index);
+            if (!border && view.contains(rect))
+            {
+                for (uint32_t i = begin; i < end; i++)
+                    visible[entries[i]] = 1;
+                visibleCount += end - begin;
+            }
+            else if (border || reach.overlaps(rect.min, rect.max))
+                for (uint32_t i = begin; i < end; i++)
+                    if (touchesView(entries[i]))
+                    {
+                        visible[entries[i]] = 1;
+                        visibleCount++;
+                    }
+        }
+    return entries.size() - visibleCount;
+}
+
+void CullStats::printSummary() const
+{
+    if (!frames || !sprites)
+        return;
+    printf("View culling: %.1f of %.1f meteor sprites culled per frame (%.1f%%), grid in %.1f%% of frames\n",
+           (double)culled / frames, (double)sprites / frames, 100.0 * culled / sprites, 100.0 * gridFrames / frames);
+}
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <glm/glm.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+// Retângulo alinhado aos eixos, em pixels do mundo
+struct CullRect
+{
+    glm::vec2 min, max;
+
+    bool overlaps(glm::vec2 otherMin, glm::vec2 otherMax) const
+    {
+        return otherMax.x >= min.x && otherMin.x <= max.x && otherMax.y >= min.y && otherMin.y <= max.y;
+    }
+    bool contains(const CullRect &other) const
+    {
+        return other.min.x >= min.x && other.max.x <= max.x && other.min.y >= min.y && other.max.y <= max.y;
+    }
+};
+
+// Grade uniforme com as sprites de cada célula (pelo centro), reconstruída a cada frame por
+// contagem: depois do primeiro frame não há alocação.
+//
+// No descarte pela câmera, células inteiramente dentro da vista aceitam todas as suas sprites sem
+// teste, células a mais de meia sprite da vista descartam todas, e só as que cruzam a borda testam
+// sprite por sprite. Centros fora da área da grade ficam nas células da borda, que são sempre
+// testadas uma a uma.
+class CullGrid
+{
+public:
+    void setup(const CullRect &area, float cellSize);
+
+    // Célula do ponto (fora da área: a célula da borda mais próxima)
+    uint32_t cellOf(glm::vec2 point) const;
+    // Monta as listas a partir da célula de cada sprite (cellOfSprite[i] veio de cellOf)
+    void build(const std::vector<uint32_t> &cellOfSprite);
+
+    // visible[i] = 1 para as sprites que tocam view, 0 para as demais; retorna quantas foram
+    // descartadas. halfExtent: maior meia dimensão entre as sprites; touchesView(i) decide as
+    // sprites das células da borda.
+    size_t cull(const CullRect &view, glm::vec2 halfExtent, std::vector<uint8_t> &visible,
+                const std::function<bool(uint32_t)> &touchesView) const;
+
+    int columns() const { return cols; }
+    int rowCount() const { return rows; }
+    CullRect cellRect(uint32_t cell) const;
+    size_t cellSize(uint32_t cell) const { return cellStart[cell + 1] - cellStart[cell]; }
+
+private:
+    CullRect area = {};
+    float cell = 1.0f;
+    int cols = 0, rows = 0;
+    std::vector<uint32_t> cellStart; // início de cada célula em entries (+ o total no fim)
+    std::vector<uint32_t> entries;   // índices das sprites, agrupados por célula
+};
+
+// Sprites descartadas por frame, para o resumo ao sair
+struct CullStats
+{
+    uint64_t frames = 0;
+    uint64_t sprites = 0;
+    uint64_t culled = 0;
+    uint64_t gridFrames = 0; // frames decididos pela grade (os demais testaram sprite por sprite)
+
+    void record(size_t frameSprites, size_t frameCulled, bool grid)
+    {
+        frames++;
+        sprites += frameSprites;
+        culled += frameCulled;
+        if (grid)
+            gridFrames++;
+    }
+    void printSummary() const;
+};
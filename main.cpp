@@ -9,6 +9,11 @@
 #include <assert.h>
 #include <random>
 #include <vector>
+#include <cmath>
+#include <fstream>
+#include <chrono>
+#include <thread>
+#include <algorithm>
 
 using namespace std;
 
@@ -26,12 +31,34 @@ using namespace std;
 // STB_IMAGE
 #include <stb_image/stb_image.h>
 
+// Módulos do jogo
+#include "engine/CommandCapture.h"
+#include "engine/DebugDraw.h"
+#include "engine/FlightRecorder.h"
+#include "engine/GameClock.h"
+#include "engine/HotReload.h"
+#include "engine/InputQueue.h"
+#include "engine/JobSystem.h"
+#include "engine/Log.h"
+#include "engine/Options.h"
+#include "engine/Particles.h"
+#include "engine/Profiler.h"
+#include "engine/RenderThread.h"
+#include "engine/ResourceRegistry.h"
+#include "engine/SpriteOutline.h"
+#include "engine/SpriteShader.h"
+#include "engine/StartupTrace.h"
+#include "engine/TimeScale.h"
+#include "engine/ViewCulling.h"
+
 using namespace glm;
 
 struct Sprite
 {
     GLuint VAO;
+    GLuint VBO;
     GLuint texID;
+    int vertexCount; // vértices da faixa de triângulos (4 no quad, até 8 com o contorno recortado)
     vec3 position;
     vec3 dimensions;
     float angle;
@@ -40,12 +67,18 @@ struct Sprite
     int iAnimation, iFrame;
     vec2 d;
     float FPS;
-    float lastTime;
+    bool opaque; // textura sem transparência (passada opaca do Renderer)
+    uint64_t framePeriod;   // ticks do GameClock entre frames da animação por tempo (0: parada)
+    uint64_t animStartTick; // instante em que a animação estava no frame iFrame
     vec2 pMin; // Minimum coordinates (top-left corner)
     vec2 pMax; // Maximum coordinates (bottom-right corner)
 
     // Função de inicialização
-    void setupSprite(int texID, vec3 position, vec3 dimensions, int nFrames, int nAnimations, vec2 pMin, vec2 pMax);
+    // outline: contorno dos pixels visíveis da folha (nullptr ou vazio: quad inteiro)
+    void setupSprite(int texID, vec3 position, vec3 dimensions, int nFrames, int nAnimations, vec2 pMin, vec2 pMax,
+                     const SpriteOutline *outline = nullptr);
+    // Libera VAO, VBO e textura
+    void destroySprite();
     vec2 getPMin() const { return vec2(position.x - (dimensions.x / 2), position.y - (dimensions.y / 2)); }
     vec2 getPMax() const { return vec2(position.x + (dimensions.x / 2), position.y + (dimensions.y / 2)); }
 };
@@ -53,6 +86,9 @@ struct Sprite
 // Vetor de meteoros
 std::vector<Sprite> meteors;
 
+// Distância percorrida pelos meteoros durante o jogo: rolagem do fundo em parallax
+double backgroundScroll = 0.0;
+
 // Estados do Jogo
 enum GameState
 {
@@ -63,15 +99,28 @@ enum GameState
 
 GameState gameState = BEFORE_START; // Initialize the game state
 
+// Troca o estado do jogo, registrando a transição no gravador de voo
+void setGameState(GameState state);
+
 // Protótipo da função de callback de teclado
 void key_callback(GLFWwindow *window, int key, int scancode, int action, int mode);
+// Callback de janela exposta / danificada: pede um redesenho
+void window_refresh_callback(GLFWwindow *window);
 
 // Protótipos das funções
-int setupShader();
-int loadTexture(string filePath, int &imgWidth, int &imgHeight);
-void drawSprite(Sprite spr, GLuint shaderID);
-void animateSpriteByTime(Sprite &spr, GLuint &shaderId, vec2 &offsetTex, float secondsToChangePicture);
-void animateSpriteByFrame(Sprite &spr, GLuint &shaderId, vec2 &offsetTex, int frameIndex);
+int loadTexture(string filePath, int &imgWidth, int &imgHeight, bool *opaque = nullptr, SpriteOutline *outline = nullptr);
+SpriteDraw makeSpriteDraw(const Sprite &spr, vec2 offsetTex);
+float animationStartSeconds(const Sprite &spr);
+void submitSprite(FrameSnapshot &frame, const Sprite &spr, vec2 offsetTex);
+void startSpriteAnimation(Sprite &spr, float reduceIntensityFPS);
+void stopSpriteAnimation(Sprite &spr);
+int currentAnimationFrame(const Sprite &spr);
+void animateSpriteByFrame(Sprite &spr, vec2 &offsetTex, int frameIndex);
+uint64_t nextAnimationTick(const Sprite &spr);
+
+// Entrada
+void consumeInput(FrameSnapshot &frame);
+bool keyDown(int key);
 
 // Colisão
 bool checkCollision(Sprite &one, Sprite &two);
@@ -80,44 +129,142 @@ void updateSpriteBounds(Sprite &spr);
 // Reset Game
 void resetGame(Sprite &spaceship, std::vector<Sprite> &meteors);
 
+// Frame do jogo (simulação + lista de desenho) e criação dos meteoros
+void updateGame(FrameSnapshot &frame, Sprite &spaceship, Sprite &startGame, Sprite &gameOver);
+void setupFrameGraph();
+void spawnMeteors(const Sprite &prototype, int count);
+
+// Benchmark
+void autopilot(const Sprite &spaceship);
+BenchmarkResult runBenchmark(GLFWwindow *window, RenderThread &renderThread, Sprite &spaceship, Sprite &startGame, Sprite &gameOver,
+                             const Sprite &meteorPrototype, int meteorCount, const BenchmarkConfig &config);
+
 // Dimensões da janela (pode ser alterado em tempo de execução)
 const GLuint WIDTH = 800, HEIGHT = 600;
 
-// Código fonte do Vertex Shader (em GLSL): ainda hardcoded
-const GLchar *vertexShaderSource = "#version 400\n"
-                                   "layout (location = 0) in vec3 position;\n"
-                                   "layout (location = 1) in vec2 texc;\n"
-                                   "uniform mat4 projection;\n"
-                                   "uniform mat4 model;\n"
-                                   "out vec2 texCoord;\n"
-                                   "void main()\n"
-                                   "{\n"
-                                   "    gl_Position = projection * model * vec4(position.x, position.y, position.z, 1.0);\n"
-                                   "    texCoord = vec2(texc.s, 1.0 - texc.t);\n"
-                                   "}\0";
-
-// Código fonte do Fragment Shader (em GLSL): ainda hardcoded
-const GLchar *fragmentShaderSource = "#version 400\n"
-                                     "in vec2 texCoord;\n"
-                                     "uniform sampler2D texBuffer;\n"
-                                     "uniform vec2 offsetTex;\n"
-                                     "out vec4 color;\n"
-                                     "void main()\n"
-                                     "{\n"
-                                     "    color = texture(texBuffer, texCoord + offsetTex);\n"
-                                     "}\n\0";
+// Redução da velocidade da animação da tela inicial e dos meteoros
+const float START_ANIMATION_SLOWDOWN = 2.0;
+const float METEOR_ANIMATION_SLOWDOWN = 3.0;
 
 float vel = 1.2;
 
 bool keys[1024] = {false};
+// Teclas pressionadas em algum momento do frame atual (um toque mais curto que um frame não se perde)
+bool keysPressed[1024] = {false};
+
+// Eventos de tecla com carimbo de tempo, consumidos no início de cada frame da simulação
+InputQueue inputQueue;
 
 bool collision = false;
 
+// Relatório de recursos pedido pelo teclado (F1)
+bool resourceReportRequested = false;
+
+// Despejo do gravador de voo pedido pelo teclado (F2)
+bool flightDumpRequested = false;
+
+// O tempo das animações que vai em float para a GPU recomeça a cada época: o GameClock inteiro
+// cresce sem limite e, em segundos float, perderia a resolução de um frame depois de alguns dias
+const uint64_t ANIMATION_EPOCH_TICKS = 60 * GameClock::TICKS_PER_SECOND;
+
+// Contador de frames apresentados
+uint32_t frameCount = 0;
+
+// Contadores de eventos da simulação (resumo da escala de tempo / soak)
+uint64_t respawnCount = 0, collisionCount = 0, gamesStarted = 0;
+
+// Grafo de tarefas do frame e o pool que o executa
+const int METEOR_CHUNKS = 4; // faixas de meteoros para limites e colisão
+JobSystem jobSystem;
+TaskGraph frameGraph;
+
+// Recarga de texturas e shaders alterados no disco (--hot-reload)
+HotReloader hotReloader;
+
+// Partículas do jogo: exaustão da nave, detritos dos meteoros e a explosão da colisão
+const int PARTICLE_CHUNKS = 4; // faixas de partículas integradas e empacotadas em paralelo
+ParticleSystem particles;
+int particleStress = 0; // partículas vivas mantidas pelo emissor de estresse (--particles)
+
+// Descarte dos meteoros fora da tela (a câmera é a própria janela). Com poucos meteoros cada faixa
+// de limites testa os seus; a partir de CULL_GRID_MIN_SPRITES a grade decide células inteiras.
+const CullRect VIEW_RECT = {vec2(0.0f, 0.0f), vec2((float)WIDTH, (float)HEIGHT)};
+const size_t CULL_GRID_MIN_SPRITES = 1024;
+bool viewCulling = true;
+CullGrid cullGrid;
+std::vector<uint8_t> meteorVisible; // 1 = toca a vista e vai para a lista de desenho
+std::vector<uint32_t> meteorCell;   // célula do centro de cada meteoro na grade
+CullStats cullStats;
+size_t lastCulledSprites = 0; // meteoros descartados no último tick (resultado do benchmark)
+// Com o descarte na GPU os meteoros vão inteiros para o Renderer, que escolhe os visíveis
+bool gpuCulling = false;
+
+// Dados do frame em execução, compartilhados pelas tarefas do grafo
+struct FrameContext
+{
+    FrameSnapshot *frame;
+    Sprite *spaceship, *startGame, *gameOver;
+    vec2 shipOffsetTex;
+    int chunkHit[METEOR_CHUNKS];
+    bool shipThrust; // foguete ligado neste tick (exaustão mais forte)
+    bool explosion;  // a nave foi atingida neste tick
+    vec2 chunkExtent[METEOR_CHUNKS]; // maior meia dimensão dos meteoros de cada faixa
+    // gameState == RUNNING depois da entrada. As tarefas leem esta cópia: resolve escreve
+    // gameState enquanto o descarte ainda roda em outra thread
+    bool running;
+};
+FrameContext frameContext;
+
+// Etapas do frame (tarefas do grafo)
+void stageInput();
+void stageShip();
+void stageMeteors();
+void stageBounds(int chunk);
+void stageCollision(int chunk);
+void stageResolveCollision();
+void stageCull();
+void stageParticles(int chunk);
+void stageParticleSpawn();
+void stagePackParticles(int chunk);
+void stageRenderList();
+void submitGpuMeteors(FrameSnapshot &frame);
+#if DEBUG_DRAW_ENABLED
+void submitDebugDraw();
+#endif
+
+// Escala de tempo ilimitada com desenho: tempo de simulação por frame apresentado
+const double UNLIMITED_FRAME_BUDGET = 0.012;
+
+// Algo mudou desde o último frame apresentado (entrada, estado, janela exposta)
+bool redrawRequested = true;
+
 // Função MAIN
-int main()
+int main(int argc, char **argv)
 {
+    startupTrace.begin();
+
+    AppOptions options;
+    if (!parseOptions(argc, argv, options))
+        return 1;
+    logStart(options.log);
+    flightRecorderStart(options.flightRecordPath);
+    gameClock.start();
+    const BenchmarkConfig &bench = options.benchmark;
+
+    // Plataforma nula com contexto OSMesa: roda sem display e sem GPU
+    if (bench.offscreen)
+        glfwInitHint(GLFW_PLATFORM, GLFW_PLATFORM_NULL);
+
+    startupTrace.precise = options.startupReport;
+
     // Inicialização da GLFW
-    glfwInit();
+    double phaseStart = startupTrace.nowMs();
+    if (!glfwInit())
+    {
+        std::cout << "Failed to initialize GLFW" << std::endl;
+        return -1;
+    }
+    startupTrace.phase("glfwInit", phaseStart);
 
     // Muita atenção aqui: alguns ambientes não aceitam essas configurações
     // Você deve adaptar para a versão do OpenGL suportada por sua placa
@@ -126,24 +273,44 @@ int main()
     glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
     glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
     glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+    // Stencil para a contagem de overdraw (--overdraw)
+    glfwWindowHint(GLFW_STENCIL_BITS, 8);
 
     // Essencial para computadores da Apple
 #ifdef __APPLE__
     glfwWindowHint(GLFW_OPENGL_FORWARD_COMPAT, GL_TRUE);
 #endif
 
+    // No benchmark e na simulação sem desenho a janela fica oculta
+    if (bench.enabled || !options.timeScale.render)
+        glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+    if (bench.offscreen)
+        glfwWindowHint(GLFW_CONTEXT_CREATION_API, GLFW_OSMESA_CONTEXT_API);
+
     // Criação da janela GLFW
+    phaseStart = startupTrace.nowMs();
     GLFWwindow *window = glfwCreateWindow(WIDTH, HEIGHT, "Spaceship Meteor", nullptr, nullptr);
+    if (!window)
+    {
+        std::cout << "Failed to create GLFW window" << std::endl;
+        glfwTerminate();
+        return -1;
+    }
     glfwMakeContextCurrent(window);
+    startupTrace.phase("window + context", phaseStart);
+    startupTrace.milestone("time to window");
 
     // Fazendo o registro da função de callback para a janela GLFW
     glfwSetKeyCallback(window, key_callback);
+    glfwSetWindowRefreshCallback(window, window_refresh_callback);
 
     // GLAD: carrega todos os ponteiros d funções da OpenGL
+    phaseStart = startupTrace.nowMs();
     if (!gladLoadGLLoader((GLADloadproc)glfwGetProcAddress))
     {
         std::cout << "Failed to initialize GLAD" << std::endl;
     }
+    startupTrace.phase("gladLoadGLLoader", phaseStart);
 
     // Obtendo as informações de versão
     const GLubyte *renderer = glGetString(GL_RENDERER); /* get renderer string */
@@ -151,188 +318,902 @@ int main()
     cout << "Renderer: " << renderer << endl;
     cout << "OpenGL version supported " << version << endl;
 
+    // Ritmo dos frames: o benchmark mede o jogo sem vsync e sem limite
+    FramePacer pacer;
+    const GLFWvidmode *videoMode = glfwGetPrimaryMonitor() ? glfwGetVideoMode(glfwGetPrimaryMonitor()) : nullptr;
+    FramePacingConfig pacing = options.pacing;
+    if (bench.enabled)
+        pacing.mode = PacingMode::Uncapped;
+    pacer.setup(pacing, videoMode ? videoMode->refreshRate : 60.0);
+    glfwSwapInterval(pacer.swapInterval());
+
     // Definindo as dimensões da viewport com as mesmas dimensões da janela da aplicação
     int width, height;
     glfwGetFramebufferSize(window, &width, &height);
     glViewport(0, 0, width, height);
 
     // Compilando e buildando o programa de shader
+    phaseStart = startupTrace.nowMs();
     GLuint shaderID = setupShader();
+    startupTrace.phase("setupShader", phaseStart);
+    if (!shaderID)
+    {
+        glfwTerminate();
+        return -1;
+    }
 
-    // Gerando um buffer simples, com a geometria de um triângulo
-    // Sprite do fundo da cena
-    Sprite background, spaceship, meteor, gameOver, startGame;
-    // Carregando uma textura (recebendo seu ID)
+    // A captura começa antes dos assets para registrar texturas e geometrias
+    if (options.capturePath)
+        captureOpen(options.capturePath, (float)WIDTH, (float)HEIGHT);
 
-    // Inicializando a sprite do background
-    int imgWidth, imgHeight;
-    int texID = loadTexture("textures/space.jpg", imgWidth, imgHeight);
-    background.setupSprite(texID, vec3(400.0, 300.0, 0.0), vec3(imgWidth * 0.2, imgHeight * 0.2, 1.0), 1, 1, vec2(0.0, 0.0), vec2(0.0, 0.0));
+    // Sprites da cena (o fundo em parallax é do Renderer)
+    Sprite spaceship, meteor, gameOver, startGame;
 
     // Inicializando a sprite da nave
-    texID = loadTexture("./textures/animated-spaceship.png", imgWidth, imgHeight);
-    spaceship.setupSprite(texID, vec3(100.0, 300.0, 0.0), vec3((imgWidth / 2) * 0.1, imgHeight * 0.1, 1.0), 2, 1, vec2(0.0, 0.0), vec2(0.0, 0.0));
+    double assetsStart = startupTrace.nowMs();
+    int imgWidth, imgHeight;
+    // Geometria recortada em volta dos pixels visíveis de cada folha (--full-quads: quad inteiro)
+    SpriteOutline outline;
+    SpriteOutline *trim = options.trimmedSprites ? &outline : nullptr;
+    outline.columns = 2;
+    int texID = loadTexture("./textures/animated-spaceship.png", imgWidth, imgHeight, nullptr, trim);
+    spaceship.setupSprite(texID, vec3(100.0, 300.0, 0.0), vec3((imgWidth / 2) * 0.1, imgHeight * 0.1, 1.0), 2, 1, vec2(0.0, 0.0), vec2(0.0, 0.0), trim);
+
+    // Inicializando a sprite do meteoro: textura e geometria compartilhadas por todos os meteoros
+    outline.columns = 6;
+    texID = loadTexture("./textures/animated-meteor.png", imgWidth, imgHeight, nullptr, trim);
+    meteor.setupSprite(texID, vec3(500.0, 300.0, 0.0), vec3((imgWidth / 6) * 0.2, imgHeight * 0.2, 1.0), 6, 1, vec2(0.0, 0.0), vec2(0.0, 0.0), trim);
 
-    // Inicializando a sprite do meteoro
     int numMeteors = 5; // Number of meteors
-    for (int i = 0; i < numMeteors; i++)
+    spawnMeteors(meteor, numMeteors);
+
+    outline.columns = 1;
+    texID = loadTexture("textures/new-game-over.png", imgWidth, imgHeight, nullptr, trim);
+    gameOver.setupSprite(texID, vec3(400.0, 300.0, 0.0), vec3(imgWidth * 0.5, imgHeight * 0.5, 1.0), 1, 1, vec2(0.0, 0.0), vec2(0.0, 0.0), trim);
+
+    outline.columns = 3;
+    texID = loadTexture("textures/start-game.png", imgWidth, imgHeight, nullptr, trim);
+    startGame.setupSprite(texID, vec3(400.0, 300.0, 0.0), vec3(imgWidth * 0.35, imgHeight * 1.06, 1.0), 3, 1, vec2(0.0, 0.0), vec2(0.0, 0.0), trim);
+    startSpriteAnimation(startGame, START_ANIMATION_SLOWDOWN);
+    startupTrace.phase("textures + sprites", assetsStart);
+
+    // Estado fixo do shader e do contexto (projeção ortográfica 800x600, transparência, profundidade)
+    Renderer spriteRenderer;
+    spriteRenderer.allowPersistentMapping = options.persistentMapping;
+    spriteRenderer.layeredPasses = options.layeredPasses;
+    spriteRenderer.measureOverdraw = options.measureOverdraw;
+    // A captura grava a lista de sprites; com o descarte na GPU os meteoros não estariam nela
+    spriteRenderer.allowGpuCulling = options.gpuCulling && options.viewCulling && !options.capturePath;
+    // Alvo da resolução dinâmica: o mesmo ritmo do pacer (taxa do monitor com vsync)
+    spriteRenderer.resolutionConfig.enabled = options.dynamicResolution;
+    if (pacing.mode == PacingMode::Capped)
+        spriteRenderer.resolutionConfig.targetFps = pacing.targetFps;
+    else if (videoMode)
+        spriteRenderer.resolutionConfig.targetFps = videoMode->refreshRate;
+    spriteRenderer.setup(shaderID, 800.0f, 600.0f);
+
+    // Depois das texturas: a lista observada não muda mais com a thread rodando
+    bool hotReload = options.hotReload && !bench.enabled && hotReloader.start(window);
+
+    // A partir daqui o contexto pertence à thread de renderização (exceto com --single-thread)
+    RenderThread renderThread;
+    renderThread.finishFirstFrame = options.startupReport;
+    renderThread.reloader = hotReload ? &hotReloader : nullptr;
+    renderThread.start(window, &spriteRenderer, options.renderThread);
+
+    // Esta thread roda o laço do jogo (e a renderização com --single-thread); os workers do grafo
+    // entram sozinhos. Poll e swap entram no driver/GLFW, que alocam por conta própria
+    allocCheckSetup(options.allocCheck);
+    allocCheckThread();
+    logRegisterThread();
+    allocCheckExemptZone(profileZoneId("glfwPollEvents"));
+    allocCheckExemptZone(profileZoneId("glfwSwapBuffers"));
+    allocCheckExemptZone(profileZoneId("debugReport"));
+
+    // Pool de tarefas do frame: por padrão, os núcleos que sobram além da simulação e da renderização
+    int jobWorkers = options.jobWorkers;
+    if (jobWorkers < 0)
+        jobWorkers = std::min(3, std::max(0, (int)std::thread::hardware_concurrency() - 2));
+    jobSystem.start(jobWorkers);
+    // O emissor de estresse não tira espaço dos efeitos do jogo
+    particles.create(ParticleSystem::DEFAULT_CAPACITY + options.particles);
+    particles.useSimd = options.simdParticles;
+    particleStress = options.particles;
+    gpuCulling = spriteRenderer.gpuCullingReady();
+    viewCulling = options.viewCulling && !gpuCulling;
+#if DEBUG_DRAW_ENABLED
+    debugDrawFlags.store(options.debugDraw);
+#endif
+    // A grade cobre a vista e a faixa onde os meteoros nascem (x até 1000) e são reciclados (x até -100)
+    cullGrid.setup({vec2(-128.0f, -128.0f), vec2(WIDTH + 256.0f, HEIGHT + 128.0f)}, 64.0f);
+    setupFrameGraph();
+
+    // Escala de tempo: passo fixo no relógio do jogo e vários ticks (ou nenhum desenho) por frame
+    const TimeScaleConfig &timeScale = options.timeScale;
+    SimStepper stepper;
+    if (timeScale.enabled() && !bench.enabled)
     {
-        Sprite meteor;
-        texID = loadTexture("./textures/animated-meteor.png", imgWidth, imgHeight);
-        meteor.setupSprite(texID, vec3(500.0 + i * 100, 300.0, 0.0), vec3((imgWidth / 6) * 0.2, imgHeight * 0.2, 1.0), 6, 1, vec2(0.0, 0.0), vec2(0.0, 0.0));
+        gameClock.setFixedStep(timeScale.tickRate);
+        stepper.setup(timeScale, monotonicSeconds());
+    }
 
-        // Randomize the Y position for each meteor
-        meteor.position.y = rand() % (HEIGHT - (int)(meteor.dimensions.y * 2)) + (int)(meteor.dimensions.y);
-        meteor.iFrame = i;
+    if (bench.enabled)
+    {
+        // Modo benchmark: uma execução ou a varredura de quantidades de meteoros
+        std::vector<int> counts = bench.sweep.empty() ? std::vector<int>{bench.meteors} : bench.sweep;
+        std::vector<BenchmarkResult> results;
+        for (int count : counts)
+        {
+            results.push_back(runBenchmark(window, renderThread, spaceship, startGame, gameOver, meteor, count, bench));
+            printBenchmarkResult(results.back());
+        }
+        if (results.size() > 1)
+            printScalingCurve(results);
+    }
+    else
+    {
+        // Loop da aplicação - "game loop"
+        bool firstFrame = true;
+        FrameSnapshot simOnlyFrame; // lista de desenho descartada com --no-render
+        while (!glfwWindowShouldClose(window))
+        {
+            // Telas de início e fim de jogo: sem entrada nem frame novo da animação, não há o que
+            // redesenhar; dorme até o próximo evento ou prazo e mantém a última imagem apresentada
+            if (options.idleRendering && !timeScale.enabled() && gameState != RUNNING && !redrawRequested && !firstFrame &&
+                particles.size() == 0)
+            {
+                double wakeAt = gameState == BEFORE_START ? GameClock::toSeconds(nextAnimationTick(startGame)) : -1.0;
+                double timeout = wakeAt - GameClock::toSeconds(gameClock.read());
+                if (wakeAt < 0.0 || timeout > 0.0)
+                {
+                    PROFILE_ZONE("idleWait");
+                    if (wakeAt < 0.0)
+                        glfwWaitEvents();
+                    else
+                        glfwWaitEventsTimeout(timeout);
+                    pacer.resync();
+                    continue;
+                }
+            }
+            redrawRequested = false;
 
-        meteors.push_back(meteor); // Add meteor to the vector
+            double frameStart = monotonicSeconds();
+            flightSetFrame(frameCount);
+
+            // Poll for events (input)
+            {
+                PROFILE_ZONE("glfwPollEvents");
+                glfwPollEvents();
+            }
+
+            // Tempo real: um tick por frame. Com escala: os ticks devidos pelo relógio real
+            int ticks = 1;
+            if (timeScale.enabled())
+            {
+                gameClock.sampleWall();
+                ticks = stepper.ticksDue(monotonicSeconds());
+                if (ticks == 0)
+                {
+                    // Câmera lenta: nenhum tick devido ainda, a imagem apresentada continua valendo
+                    PROFILE_ZONE("idleWait");
+                    std::this_thread::sleep_for(std::chrono::duration<double>(stepper.secondsUntilNextTick()));
+                    pacer.resync();
+                    continue;
+                }
+            }
+
+            double workStart = monotonicSeconds();
+            FrameSnapshot &frame = timeScale.render ? renderThread.beginFrame() : simOnlyFrame;
+            frame.reset(frameCount);
+            for (int tick = 0; tick < ticks; tick++)
+            {
+                // Só a lista de desenho do último tick é apresentada
+                frame.sprites.clear();
+                frame.gpuMeteors.instances.clear();
+#if DEBUG_DRAW_ENABLED
+                frame.debugVertices.clear();
+#endif
+                if (timeScale.soakSeconds > 0.0)
+                    autopilot(spaceship);
+                updateGame(frame, spaceship, startGame, gameOver);
+                if (stepper.unlimited() && timeScale.render && monotonicSeconds() - workStart > UNLIMITED_FRAME_BUDGET)
+                    ticks = tick + 1;
+            }
+            stepper.ticksRan(ticks);
+            double workEnd = monotonicSeconds();
+
+            // Entrega o frame para desenho e apresentação (swap) na thread de renderização
+            if (timeScale.render)
+            {
+                renderThread.publish();
+                stepper.framePresented();
+            }
+
+            frameCount++;
+            flightRecord(FLIGHT_FRAME, 0, 0, (float)((monotonicSeconds() - frameStart) * 1000.0),
+                         (float)((workEnd - workStart) * 1000.0));
+            profilerEndFrame();
+            allocCheckEndFrame(gameState == RUNNING);
+
+            if (resourceReportRequested)
+            {
+                PROFILE_ZONE("debugReport");
+                resourceReportRequested = false;
+                printResourceReport();
+            }
+            if (flightDumpRequested)
+            {
+                PROFILE_ZONE("debugReport");
+                flightDumpRequested = false;
+                if (flightDump(FLIGHT_DUMP_HOTKEY))
+                    LOG(LOG_INFO, LOG_ENGINE, "flight recorder written to %s", options.flightRecordPath);
+            }
+
+            if (timeScale.render)
+            {
+                PROFILE_ZONE("framePacing");
+                pacer.endFrame();
+            }
+
+            if (firstFrame && timeScale.render)
+            {
+                firstFrame = false;
+                renderThread.waitPresented(1);
+                startupTrace.milestone("time to first frame");
+                if (options.startupReport)
+                {
+                    startupTrace.print();
+                    break;
+                }
+            }
+            if (stepper.soakDone())
+                break;
+        }
     }
 
-    texID = loadTexture("textures/new-game-over.png", imgWidth, imgHeight);
-    gameOver.setupSprite(texID, vec3(400.0, 300.0, 0.0), vec3(imgWidth * 0.5, imgHeight * 0.5, 1.0), 1, 1, vec2(0.0, 0.0), vec2(0.0, 0.0));
+    // Devolve o contexto GL para esta thread antes da limpeza
+    renderThread.stop();
+    jobSystem.stop();
+    if (hotReload)
+        hotReloader.stop();
+    captureClose();
 
-    texID = loadTexture("textures/start-game.png", imgWidth, imgHeight);
-    startGame.setupSprite(texID, vec3(400.0, 300.0, 0.0), vec3(imgWidth * 0.35, imgHeight * 1.06, 1.0), 3, 1, vec2(0.0, 0.0), vec2(0.0, 0.0));
+    if (options.allocCheck.enabled)
+    {
+        profilerPrintSummary();
+        allocCheckPrintSummary();
+    }
 
-    glUseProgram(shaderID);
+    if (timeScale.enabled() && !bench.enabled)
+    {
+        stepper.printSummary(monotonicSeconds());
+        cout << "Simulated events: " << gamesStarted << " games, " << respawnCount << " meteor respawns, " << collisionCount
+             << " collisions" << endl;
+    }
+    if (!bench.enabled && timeScale.render)
+    {
+        pacer.printSummary();
+        inputLatency.printSummary();
+        if (inputQueue.dropped())
+            cout << "Input queue overflow: " << inputQueue.dropped() << " key events dropped" << endl;
+    }
+    frameGraph.printTimings();
+    cullStats.printSummary();
+    particles.printSummary();
+    spriteRenderer.instanceStream().printSummary();
+    if (spriteRenderer.particleStream().buffer())
+        spriteRenderer.particleStream().printSummary();
+    spriteRenderer.printOverdrawSummary();
+    spriteRenderer.printGpuCullingSummary();
+    spriteRenderer.dynamicResolution().printSummary();
+    printResourceReport();
+    flightDump(FLIGHT_DUMP_EXIT);
+
+    // Limpeza de memória (os meteoros compartilham os recursos do protótipo)
+    meteors.clear();
+    spaceship.destroySprite();
+    meteor.destroySprite();
+    gameOver.destroySprite();
+    startGame.destroySprite();
+    spriteRenderer.destroy();
+    glDeleteProgram(shaderID);
+
+    printResourceLeaks();
+    glfwTerminate();
+    logStop();
 
-    // Enviando a cor desejada (vec4) para o fragment shader
-    // Utilizamos a variáveis do tipo uniform em GLSL para armazenar esse tipo de info
-    // que não está nos buffers
-    glUniform1i(glGetUniformLocation(shaderID, "texBuffer"), 0);
+    return 0;
+}
 
-    // Matriz de projeção ortográfica
-    mat4 projection = ortho(0.0f, 800.0f, 0.0f, 600.0f, -1.0f, 1.0f);
+// Atualiza um frame do jogo e monta sua lista de desenho (sem chamadas GL), executando o grafo de
+// tarefas do frame (ver setupFrameGraph)
+void updateGame(FrameSnapshot &frame, Sprite &spaceship, Sprite &startGame, Sprite &gameOver)
+{
+    PROFILE_ZONE("updateGame");
+
+    frameContext.frame = &frame;
+    frameContext.spaceship = &spaceship;
+    frameContext.startGame = &startGame;
+    frameContext.gameOver = &gameOver;
+#if DEBUG_DRAW_ENABLED
+    debugDrawTarget(&frame.debugVertices);
+    jobSystem.run(frameGraph);
+    // O snapshot vai para a thread de renderização: nada mais escreve nele
+    debugDrawTarget(nullptr);
+#else
+    jobSystem.run(frameGraph);
+#endif
+}
 
-    glUniformMatrix4fv(glGetUniformLocation(shaderID, "projection"), 1, GL_FALSE, value_ptr(projection));
+// Monta o grafo de tarefas do frame:
+//
+//   input -> nave ------------------+--> colisão[i] -> resolução --+--> lista de desenho
+//         -> meteoros -> limites[i] +--> descarte -----------------/
+//         -> partículas[i] ---------------------------- (resolução) --> emissão -> empacotamento[i]
+//
+// Limites e colisão são divididos em faixas de meteoros (com poucos meteoros os limites já marcam
+// quem está na tela; com muitos, o descarte usa a grade); integração e empacotamento das
+// partículas, em faixas de partículas. A emissão (e a remoção das mortas) é serial e espera a
+// colisão, que decide a explosão. A animação por tempo não tem tarefa: o frame de cada sprite é
+// escolhido no vertex shader, então meteoros descartados não custam nada e voltam no frame certo.
+// O envio para a GL continua na thread de renderização.
+void setupFrameGraph()
+{
+    int input = frameGraph.add("task input", stageInput);
+    int ship = frameGraph.add("task ship", stageShip);
+    int meteorMove = frameGraph.add("task meteors", stageMeteors);
+    int resolve = frameGraph.add("task resolve", stageResolveCollision);
+    int cull = frameGraph.add("task cull", stageCull);
+    int renderList = frameGraph.add("task render list", stageRenderList);
+    int particleSpawn = frameGraph.add("task particle spawn", stageParticleSpawn);
+
+    frameGraph.dependsOn(ship, input);
+    frameGraph.dependsOn(meteorMove, input);
+    for (int chunk = 0; chunk < METEOR_CHUNKS; chunk++)
+    {
+        int bounds = frameGraph.add("task bounds", [chunk] { stageBounds(chunk); });
+        int collide = frameGraph.add("task collision", [chunk] { stageCollision(chunk); });
+        frameGraph.dependsOn(bounds, meteorMove);
+        frameGraph.dependsOn(collide, bounds);
+        frameGraph.dependsOn(collide, ship);
+        frameGraph.dependsOn(resolve, collide);
+        frameGraph.dependsOn(cull, bounds);
+    }
+    frameGraph.dependsOn(renderList, resolve);
+    frameGraph.dependsOn(renderList, cull);
 
-    // Ativando o primeiro buffer de textura da OpenGL
-    glActiveTexture(GL_TEXTURE0);
+    frameGraph.dependsOn(particleSpawn, resolve);
+    for (int chunk = 0; chunk < PARTICLE_CHUNKS; chunk++)
+    {
+        int integrate = frameGraph.add("task particles", [chunk] { stageParticles(chunk); });
+        int pack = frameGraph.add("task particle pack", [chunk] { stagePackParticles(chunk); });
+        frameGraph.dependsOn(integrate, input);
+        frameGraph.dependsOn(particleSpawn, integrate);
+        frameGraph.dependsOn(pack, particleSpawn);
+    }
+}
 
-    // Habilitar a transparência
-    glEnable(GL_BLEND);
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+// Faixa [begin, end) de meteoros da tarefa chunk
+static void meteorChunk(int chunk, size_t &begin, size_t &end)
+{
+    begin = meteors.size() * chunk / METEOR_CHUNKS;
+    end = meteors.size() * (chunk + 1) / METEOR_CHUNKS;
+}
 
-    // Habilitar o teste de profundidade
-    glEnable(GL_DEPTH_TEST);
-    glDepthFunc(GL_ALWAYS);
+// Relógio, entrada e transições de estado pedidas pelo teclado
+void stageInput()
+{
+    // Relógio amostrado uma vez por frame; depois, só as animações com prazo vencido trocam de frame
+    gameClock.tick();
+    consumeInput(*frameContext.frame);
 
-    // Loop da aplicação - "game loop"
-    while (!glfwWindowShouldClose(window))
+    if (gameState == BEFORE_START && keyDown(GLFW_KEY_ENTER))
+        setGameState(RUNNING);
+    else if (gameState == GAME_OVER && keyDown(GLFW_KEY_SPACE))
     {
+        setGameState(BEFORE_START);
+        resetGame(*frameContext.spaceship, meteors);
+        particles.clear();
+    }
+    frameContext.running = gameState == RUNNING;
+}
 
-        // Poll for events (input)
-        glfwPollEvents();
+// Movimento da nave
+void stageShip()
+{
+    frameContext.shipThrust = false;
+    if (!frameContext.running)
+        return;
 
-        // Clear the color buffer
-        glClearColor(0.0f, 0.0f, 0.0f, 1.0f); // Background color
-        glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+    Sprite &spaceship = *frameContext.spaceship;
+    vec2 &offsetTex = frameContext.shipOffsetTex;
+    float gravity = 0.3;
 
-        vec2 offsetTex = vec2(0.0, 0.0);
-        glUniform2f(glGetUniformLocation(shaderID, "offsetTex"), offsetTex.s, offsetTex.t);
+    // Mantém a animação para foguete desligado por default.
+    animateSpriteByFrame(spaceship, offsetTex, 1);
 
-        // Draw the background
-        drawSprite(background, shaderID);
+    // Movement controls
+    if ((keyDown(GLFW_KEY_LEFT) || keyDown(GLFW_KEY_A)) && (spaceship.position.x - vel) > 30)
+    { // movimenta X -> esquerda
+        spaceship.position.x -= vel;
+    }
+    if ((keyDown(GLFW_KEY_RIGHT) || keyDown(GLFW_KEY_D)) && (spaceship.position.x + vel) < (WIDTH - 30))
+    { // movimenta X -> direita
+        spaceship.position.x += vel;
+    }
+    if ((keyDown(GLFW_KEY_UP) || keyDown(GLFW_KEY_W)) && (spaceship.position.y + vel) < (HEIGHT - 30))
+    { // movimenta Y -> cima
+        // Muda animação para foguete ligado.
+        animateSpriteByFrame(spaceship, offsetTex, 0);
+        frameContext.shipThrust = true;
+        spaceship.position.y += vel;
+    }
+    if ((keyDown(GLFW_KEY_DOWN) || keyDown(GLFW_KEY_S)) && (spaceship.position.y - vel) > 30)
+    { // movimenta Y -> baixo.
+        // Muda animação para foguete desligado.
+        animateSpriteByFrame(spaceship, offsetTex, 1);
+        spaceship.position.y -= vel;
+    }
 
-        if (gameState == BEFORE_START) // Processo antes do jogo começar
-        {
-            animateSpriteByTime(startGame, shaderID, offsetTex, 2.0);
-            drawSprite(startGame, shaderID);
+    // Adiciono o peso da gravidade.
+    if ((spaceship.position.y - gravity) > 30)
+        spaceship.position.y -= gravity; // adiciona peso da gravidade.
 
-            // Tecla Espaço
-            if (keys[GLFW_KEY_ENTER])
-            {
-                gameState = RUNNING;
-            }
+    updateSpriteBounds(spaceship); // atualiza limites da espaço nave.
+}
+
+// Movimento dos meteoros (uma tarefa só: o reposicionamento usa rand())
+void stageMeteors()
+{
+    if (!frameContext.running)
+        return;
+
+    // O fundo rola junto com os meteoros (cada camada em uma fração dessa distância)
+    backgroundScroll += vel;
+    for (size_t i = 0; i < meteors.size(); i++)
+    {
+        meteors[i].position.x -= vel; // Move each meteor left
+
+        // If the meteor moves off-screen, reset its position to a random location on the right
+        if (meteors[i].position.x < -100)
+        { // Adjust as needed for your sprite's width
+            meteors[i].position.x = WIDTH;
+            meteors[i].position.y = rand() % (HEIGHT - (int)(meteors[i].dimensions.y * 2)) + (int)(meteors[i].dimensions.y); // New random Y position
+            flightRecord(FLIGHT_RESPAWN, 0, (uint32_t)i, meteors[i].position.x, meteors[i].position.y);
+            LOG(LOG_DEBUG, LOG_SPAWN, "meteor %zu respawned at y=%.1f", i, meteors[i].position.y);
+            respawnCount++;
         }
-        else if (gameState == RUNNING) // Processo durante o jogo
+    }
+}
+
+// Limites para a colisão de uma faixa de meteoros
+void stageBounds(int chunk)
+{
+    if (!frameContext.running)
+        return;
+
+    size_t begin, end;
+    meteorChunk(chunk, begin, end);
+    bool useGrid = viewCulling && meteors.size() >= CULL_GRID_MIN_SPRITES;
+    // A camada de depuração mostra a grade mesmo quando ela não decide o descarte
+    bool needCells = useGrid || debugDrawOn(DEBUG_DRAW_CELLS);
+    vec2 extent(0.0f);
+    for (size_t i = begin; i < end; i++)
+    {
+        Sprite &m = meteors[i];
+        updateSpriteBounds(m);
+        extent = glm::max(extent, vec2(m.dimensions) * 0.5f);
+        if (needCells)
+            meteorCell[i] = cullGrid.cellOf(vec2(m.position));
+        if (!useGrid)
+            meteorVisible[i] = !viewCulling || VIEW_RECT.overlaps(m.pMin, m.pMax);
+    }
+    frameContext.chunkExtent[chunk] = extent;
+}
+
+// Descarte pela grade, com as células de todas as faixas prontas (muitos meteoros)
+void stageCull()
+{
+    if (!frameContext.running)
+        return;
+    bool useGrid = viewCulling && meteors.size() >= CULL_GRID_MIN_SPRITES;
+    if (!useGrid && !debugDrawOn(DEBUG_DRAW_CELLS))
+        return;
+    cullGrid.build(meteorCell);
+    if (!useGrid)
+        return;
+
+    vec2 halfExtent(0.0f);
+    for (int chunk = 0; chunk < METEOR_CHUNKS; chunk++)
+        halfExtent = glm::max(halfExtent, frameContext.chunkExtent[chunk]);
+    cullGrid.cull(VIEW_RECT, halfExtent, meteorVisible,
+                  [](uint32_t i) { return VIEW_RECT.overlaps(meteors[i].pMin, meteors[i].pMax); });
+}
+
+// Primeiro meteoro da faixa que bate na nave (-1: nenhum)
+void stageCollision(int chunk)
+{
+    frameContext.chunkHit[chunk] = -1;
+    if (!frameContext.running)
+        return;
+
+    size_t begin, end;
+    meteorChunk(chunk, begin, end);
+    for (size_t i = begin; i < end; i++)
+        if (checkCollision(*frameContext.spaceship, meteors[i]))
         {
-            float gravity = 0.3;
+            frameContext.chunkHit[chunk] = (int)i;
+            break;
+        }
+}
 
-            // Mantém a animação para foguete desligado por default.
-            animateSpriteByFrame(spaceship, shaderID, offsetTex, 1);
+// A colisão de menor índice encerra o jogo (mesma escolha da versão sequencial)
+void stageResolveCollision()
+{
+    collision = false;
+    for (int chunk = 0; chunk < METEOR_CHUNKS && !collision; chunk++)
+    {
+        int hit = frameContext.chunkHit[chunk];
+        if (hit < 0)
+            continue;
+        collision = true;
+        const Sprite &spaceship = *frameContext.spaceship;
+        flightRecord(FLIGHT_COLLISION, 0, (uint32_t)hit, spaceship.position.x, spaceship.position.y);
+        LOG(LOG_DEBUG, LOG_COLLISION, "meteor %d hit the ship at %.1f,%.1f", hit, spaceship.position.x, spaceship.position.y);
+        collisionCount++;
+        setGameState(GAME_OVER);
+    }
+    frameContext.explosion = collision;
+}
 
-            // Movement controls
-            if ((keys[GLFW_KEY_LEFT] || keys[GLFW_KEY_A]) && (spaceship.position.x - vel) > 30)
-            { // movimenta X -> esquerda
-                spaceship.position.x -= vel;
-            }
-            if ((keys[GLFW_KEY_RIGHT] || keys[GLFW_KEY_D]) && (spaceship.position.x + vel) < (WIDTH - 30))
-            { // movimenta X -> direita
-                spaceship.position.x += vel;
-            }
-            if ((keys[GLFW_KEY_UP] || keys[GLFW_KEY_W]) && (spaceship.position.y + vel) < (HEIGHT - 30))
-            { // movimenta Y -> cima
-                // Muda animação para foguete ligado.
-                animateSpriteByFrame(spaceship, shaderID, offsetTex, 0);
-                spaceship.position.y += vel;
-            }
-            if ((keys[GLFW_KEY_DOWN] || keys[GLFW_KEY_S]) && (spaceship.position.y - vel) > 30)
-            { // movimenta Y -> baixo.
-                // Muda animação para foguete desligado.
-                animateSpriteByFrame(spaceship, shaderID, offsetTex, 1);
-                spaceship.position.y -= vel;
-            }
+// Integração de uma faixa de partículas (as emitidas neste tick começam a andar no próximo)
+void stageParticles(int chunk)
+{
+    size_t begin, end;
+    particles.chunkRange(chunk, PARTICLE_CHUNKS, begin, end);
+    particles.integrate(begin, end, 1.0f);
+}
 
-            // Adiciono o peso da gravidade.
-            if ((spaceship.position.y - gravity) > 30)
-                spaceship.position.y -= gravity; // adiciona peso da gravidade.
+// Remove as partículas mortas e emite as novas a partir do estado do tick
+void stageParticleSpawn()
+{
+    particles.compact();
+    const Sprite &spaceship = *frameContext.spaceship;
 
-            updateSpriteBounds(spaceship);   // atualiza limites da espaço nave.
-            drawSprite(spaceship, shaderID); // desenha sprite da nave.
+    if (gameState == RUNNING)
+    {
+        // Exaustão: sai do bocal (embaixo e à esquerda do centro da nave) para trás, e fica para
+        // trás na mesma velocidade em que o cenário passa
+        ParticleSpawn exhaust;
+        exhaust.x = spaceship.position.x - spaceship.dimensions.x * 0.12f;
+        exhaust.y = spaceship.position.y - spaceship.dimensions.y * 0.09f;
+        exhaust.spreadX = exhaust.spreadY = 1.5f;
+        exhaust.baseVX = -vel;
+        exhaust.angle = 3.9f;
+        exhaust.spread = 0.6f;
+        exhaust.speedMin = 1.0f;
+        exhaust.speedMax = frameContext.shipThrust ? 3.0f : 1.5f;
+        exhaust.lifeMin = 10.0f;
+        exhaust.lifeMax = frameContext.shipThrust ? 30.0f : 15.0f;
+        exhaust.sizeMin = 2.0f;
+        exhaust.sizeMax = 4.0f;
+        const float flame[4] = {1.0f, 0.9f, 0.3f, 1.0f}, ember[4] = {0.8f, 0.15f, 0.05f, 0.0f};
+        std::copy(flame, flame + 4, exhaust.startColor);
+        std::copy(ember, ember + 4, exhaust.endColor);
+        particles.emit(exhaust, frameContext.shipThrust ? 8 : 2);
+
+        // Detritos: poeira solta pela traseira de cada meteoro, um tick sim e outro não
+        ParticleSpawn debris;
+        debris.baseVX = -vel * 0.4f;
+        debris.speedMin = 0.05f;
+        debris.speedMax = 0.4f;
+        debris.lifeMin = 30.0f;
+        debris.lifeMax = 60.0f;
+        debris.sizeMin = 1.5f;
+        debris.sizeMax = 3.0f;
+        const float dust[4] = {0.55f, 0.45f, 0.35f, 0.8f}, faded[4] = {0.3f, 0.25f, 0.2f, 0.0f};
+        std::copy(dust, dust + 4, debris.startColor);
+        std::copy(faded, faded + 4, debris.endColor);
+        for (size_t i = frameCount & 1; i < meteors.size(); i += 2)
+        {
+            const Sprite &m = meteors[i];
+            debris.x = m.position.x + m.dimensions.x * 0.3f;
+            debris.y = m.position.y;
+            debris.spreadX = m.dimensions.x * 0.1f;
+            debris.spreadY = m.dimensions.y * 0.3f;
+            particles.emit(debris, 1);
+        }
+    }
 
-            // Atualização meteoros na tela
-            for (size_t i = 0; i < meteors.size(); i++)
-            {
-                meteors[i].position.x -= vel; // Move each meteor left
+    // Explosão da colisão: continua visível por cima da tela de fim de jogo até se apagar
+    if (frameContext.explosion)
+    {
+        ParticleSpawn blast;
+        blast.x = spaceship.position.x;
+        blast.y = spaceship.position.y;
+        blast.spreadX = spaceship.dimensions.x * 0.2f;
+        blast.spreadY = spaceship.dimensions.y * 0.2f;
+        blast.speedMin = 0.5f;
+        blast.speedMax = 5.0f;
+        blast.lifeMin = 40.0f;
+        blast.lifeMax = 100.0f;
+        blast.sizeMin = 2.0f;
+        blast.sizeMax = 5.0f;
+        const float flash[4] = {1.0f, 0.95f, 0.6f, 1.0f}, smoke[4] = {0.7f, 0.1f, 0.0f, 0.0f};
+        std::copy(flash, flash + 4, blast.startColor);
+        std::copy(smoke, smoke + 4, blast.endColor);
+        particles.emit(blast, 1500);
+    }
 
-                // If the meteor moves off-screen, reset its position to a random location on the right
-                if (meteors[i].position.x < -100)
-                { // Adjust as needed for your sprite's width
-                    meteors[i].position.x = WIDTH;
-                    meteors[i].position.y = rand() % (HEIGHT - (int)(meteors[i].dimensions.y * 2)) + (int)(meteors[i].dimensions.y); // New random Y position
-                }
+    // Estresse: completa as partículas vivas até particleStress, espalhadas pela tela
+    if (particleStress > (int)particles.size())
+    {
+        ParticleSpawn stress;
+        stress.x = WIDTH * 0.5f;
+        stress.y = HEIGHT * 0.5f;
+        stress.spreadX = WIDTH * 0.5f;
+        stress.spreadY = HEIGHT * 0.5f;
+        stress.baseVX = -vel;
+        stress.speedMax = 0.5f;
+        stress.lifeMin = 60.0f;
+        stress.lifeMax = 180.0f;
+        stress.sizeMin = 1.0f;
+        stress.sizeMax = 2.0f;
+        particles.emit(stress, particleStress - (int)particles.size());
+    }
 
-                // Update bounds for collision detection
-                updateSpriteBounds(meteors[i]);
+    // Vetor do snapshot com espaço para o pool inteiro já na primeira vez: sem alocação depois
+    FrameSnapshot &frame = *frameContext.frame;
+    if (frame.particles.capacity() < particles.maxSize())
+        frame.particles.reserve(particles.maxSize());
+    frame.particles.resize(particles.size());
+}
 
-                // Check for collision with the spaceship
-                collision = checkCollision(spaceship, meteors[i]);
+// Conversão de uma faixa de partículas para o formato de desenho
+void stagePackParticles(int chunk)
+{
+    size_t begin, end;
+    particles.chunkRange(chunk, PARTICLE_CHUNKS, begin, end);
+    particles.pack(begin, end, frameContext.frame->particles.data());
+}
 
-                if (collision)
+// Lista de desenho do frame, de trás para frente
+void stageRenderList()
+{
+    FrameSnapshot &frame = *frameContext.frame;
+    vec2 offsetTex = vec2(0.0, 0.0);
+    frame.time = (float)GameClock::toSeconds(gameClock.now() % ANIMATION_EPOCH_TICKS);
+    // O fundo em parallax é desenhado pelo Renderer antes das sprites
+    frame.backgroundScroll = backgroundScroll;
+
+    if (gameState == BEFORE_START) // Processo antes do jogo começar
+        submitSprite(frame, *frameContext.startGame, offsetTex);
+    else if (gameState == RUNNING) // Processo durante o jogo
+    {
+        submitSprite(frame, *frameContext.spaceship, frameContext.shipOffsetTex); // desenha sprite da nave.
+        if (gpuCulling)
+            submitGpuMeteors(frame);
+        else
+        {
+            // Meteoros fora da tela ficam de fora; a animação por tempo não depende de ter sido desenhada
+            size_t culled = 0;
+            for (size_t i = 0; i < meteors.size(); i++)
+            {
+                if (!meteorVisible[i])
                 {
-                    gameState = GAME_OVER;
-                    break; // Exit the loop if collision occurs
+                    culled++;
+                    continue;
                 }
-
-                animateSpriteByTime(meteors[i], shaderID, offsetTex, 3.0);
-                drawSprite(meteors[i], shaderID); // desenha sprite dos meteóros.
+                submitSprite(frame, meteors[i], offsetTex); // desenha sprite dos meteóros.
             }
+            lastCulledSprites = culled;
+            cullStats.record(meteors.size(), culled, viewCulling && meteors.size() >= CULL_GRID_MIN_SPRITES);
         }
-        else if (gameState == GAME_OVER) // Processo fim de jogo.
+#if DEBUG_DRAW_ENABLED
+        submitDebugDraw();
+#endif
+    }
+    else if (gameState == GAME_OVER) // Processo fim de jogo.
+        submitSprite(frame, *frameContext.gameOver, vec2(0.0, 0.0));
+}
+
+// Caminho do descarte na GPU: todos os meteoros, só com o que muda de um para outro (a textura, a
+// geometria e a animação são as do primeiro, de quem todos são cópia em spawnMeteors)
+void submitGpuMeteors(FrameSnapshot &frame)
+{
+    if (meteors.empty())
+        return;
+    frame.gpuMeteors.prototype = makeSpriteDraw(meteors[0], vec2(0.0, 0.0));
+    frame.gpuMeteors.instances.resize(meteors.size());
+    for (size_t i = 0; i < meteors.size(); i++)
+    {
+        const Sprite &meteor = meteors[i];
+        MeteorState &state = frame.gpuMeteors.instances[i];
+        state.position[0] = meteor.position.x;
+        state.position[1] = meteor.position.y;
+        // Como em makeSpriteDraw: sem animação por tempo fica no frame 0
+        state.animStart = meteor.framePeriod ? animationStartSeconds(meteor) : 0.0f;
+        state.animFirstFrame = meteor.framePeriod ? (float)meteor.iFrame : 0.0f;
+    }
+    lastCulledSprites = 0;
+}
+
+#if DEBUG_DRAW_ENABLED
+// Camada de depuração (F3 caixas, F4 pares, F5 células ou --debug-draw): chamada na lista de
+// desenho, com a colisão resolvida e a grade montada
+void submitDebugDraw()
+{
+    const Sprite &spaceship = *frameContext.spaceship;
+    char label[16];
+
+    if (debugDrawOn(DEBUG_DRAW_CELLS))
+        for (uint32_t cell = 0; cell < (uint32_t)(cullGrid.columns() * cullGrid.rowCount()); cell++)
         {
-            drawSprite(gameOver, shaderID);
+            size_t count = cullGrid.cellSize(cell);
+            if (!count)
+                continue;
+            // Células mais cheias ficam mais opacas
+            CullRect rect = cullGrid.cellRect(cell);
+            debugFilledRect(rect.min, rect.max, {40, 120, 255, (uint8_t)std::min<size_t>(24 + count * 12, 140)});
+            debugRect(rect.min, rect.max, {80, 160, 255, 160});
+            snprintf(label, sizeof(label), "%zu", count);
+            debugText(rect.min + vec2(3.0f), {200, 230, 255, 255}, label);
+        }
 
-            // Tecla Espaço
-            if (keys[GLFW_KEY_SPACE])
-            {
-                gameState = BEFORE_START;
-                resetGame(spaceship, meteors);
-            }
+    if (debugDrawOn(DEBUG_DRAW_AABBS))
+    {
+        debugRect(spaceship.pMin, spaceship.pMax, {80, 255, 80, 255});
+        for (size_t i = 0; i < meteors.size(); i++)
+            if (meteorVisible[i])
+                debugRect(meteors[i].pMin, meteors[i].pMax, {255, 220, 60, 255});
+    }
+
+    if (debugDrawOn(DEBUG_DRAW_PAIRS))
+    {
+        // Pares nave-meteoro a menos de um tamanho de nave: laranja perto, vermelho em colisão
+        CullRect ship = {spaceship.pMin, spaceship.pMax};
+        CullRect reach = {spaceship.pMin - vec2(spaceship.dimensions), spaceship.pMax + vec2(spaceship.dimensions)};
+        for (size_t i = 0; i < meteors.size(); i++)
+        {
+            const Sprite &m = meteors[i];
+            if (!reach.overlaps(m.pMin, m.pMax))
+                continue;
+            bool hit = ship.overlaps(m.pMin, m.pMax);
+            DebugColor color = hit ? DebugColor{255, 40, 40, 255} : DebugColor{255, 150, 40, 200};
+            debugLine(vec2(spaceship.position), vec2(m.position), color);
+            snprintf(label, sizeof(label), hit ? "HIT %zu" : "%zu", i);
+            debugText(vec2(m.position) + vec2(4.0f, 4.0f), color, label);
         }
+    }
+}
+#endif
 
-        // Swap buffers to display the drawn frame
-        glfwSwapBuffers(window);
+// Cria os meteoros a partir de um protótipo (mesma textura e VAO), espalhados entre x = 500 e x = 1000
+void spawnMeteors(const Sprite &prototype, int count)
+{
+    for (Sprite &old : meteors)
+        stopSpriteAnimation(old);
+    meteors.clear();
+    meteors.reserve(count);
+    meteorVisible.assign(count, 1);
+    meteorCell.assign(count, 0);
+    for (int i = 0; i < count; i++)
+    {
+        Sprite meteor = prototype;
+        meteor.position.x = 500.0 + i * (500.0 / count);
+
+        // Randomize the Y position for each meteor
+        meteor.position.y = rand() % (HEIGHT - (int)(meteor.dimensions.y * 2)) + (int)(meteor.dimensions.y);
+        meteor.iFrame = i % meteor.nFrames;
+        updateSpriteBounds(meteor);
+
+        meteors.push_back(meteor); // Add meteor to the vector
     }
+    for (Sprite &meteor : meteors)
+        startSpriteAnimation(meteor, METEOR_ANIMATION_SLOWDOWN);
+}
 
-    // Limpeza de memória
-    glDeleteVertexArrays(1, &background.VAO);
-    glDeleteVertexArrays(1, &spaceship.VAO);
-    glDeleteVertexArrays(1, &meteor.VAO);
-    glDeleteVertexArrays(1, &gameOver.VAO);
-    glfwTerminate();
+// Piloto automático do benchmark: desvia do meteoro mais próximo à frente da nave
+// e reinicia a partida (Espaço, depois Enter) quando bate
+void autopilot(const Sprite &spaceship)
+{
+    keys[GLFW_KEY_ENTER] = (gameState == BEFORE_START);
+    keys[GLFW_KEY_SPACE] = (gameState == GAME_OVER);
+    keys[GLFW_KEY_UP] = false;
+    keys[GLFW_KEY_DOWN] = false;
+    if (gameState != RUNNING)
+        return;
+
+    const Sprite *threat = nullptr;
+    for (size_t i = 0; i < meteors.size(); i++)
+    {
+        const Sprite &m = meteors[i];
+        float dx = m.position.x - spaceship.position.x;
+        float reachY = (m.dimensions.y + spaceship.dimensions.y) * 0.5f + 10.0f;
+        if (dx < -m.dimensions.x || dx > 250.0f || fabs(m.position.y - spaceship.position.y) > reachY)
+            continue;
+        if (!threat || m.position.x < threat->position.x)
+            threat = &m;
+    }
+    if (!threat)
+        return;
+
+    // Foge na direção oposta ao meteoro, a menos que esteja encostado na borda
+    bool goDown = threat->position.y > spaceship.position.y;
+    if (goDown && spaceship.position.y < 60.0f)
+        goDown = false;
+    else if (!goDown && spaceship.position.y > HEIGHT - 60.0f)
+        goDown = true;
+    keys[goDown ? GLFW_KEY_DOWN : GLFW_KEY_UP] = true;
+}
 
-    return 0;
+// Executa uma rodada do benchmark: começa em RUNNING com semente fixa, sem vsync,
+// e mede o tempo de cada frame (entrada + simulação + desenho + swap)
+BenchmarkResult runBenchmark(GLFWwindow *window, RenderThread &renderThread, Sprite &spaceship, Sprite &startGame, Sprite &gameOver,
+                             const Sprite &meteorPrototype, int meteorCount, const BenchmarkConfig &config)
+{
+    srand(config.seed);
+    spawnMeteors(meteorPrototype, meteorCount);
+    particles.clear();
+    spaceship.position = vec3(100.0f, 300.0f, 0.0f);
+    setGameState(RUNNING);
+
+    BenchmarkRecorder recorder;
+    int totalFrames = config.warmupFrames + config.frames;
+    for (int frame = 0; frame < totalFrames && !glfwWindowShouldClose(window); frame++)
+    {
+        if (frame == config.warmupFrames)
+            recorder.begin(meteorCount, config.frames);
+
+        double start = monotonicSeconds();
+        GameState previous = gameState;
+        flightSetFrame(frameCount);
+
+        {
+            PROFILE_ZONE("glfwPollEvents");
+            glfwPollEvents();
+        }
+        autopilot(spaceship);
+        double workStart = monotonicSeconds();
+        FrameSnapshot &snapshot = renderThread.beginFrame();
+        snapshot.reset(frameCount);
+        updateGame(snapshot, spaceship, startGame, gameOver);
+        double workEnd = monotonicSeconds();
+        renderThread.publish();
+        frameCount++;
+        flightRecord(FLIGHT_FRAME, 0, 0, (float)((monotonicSeconds() - start) * 1000.0), (float)((workEnd - workStart) * 1000.0));
+        profilerEndFrame();
+        allocCheckEndFrame(gameState == RUNNING);
+
+        if (frame >= config.warmupFrames)
+        {
+            recorder.frame((monotonicSeconds() - start) * 1000.0, previous == RUNNING, previous == RUNNING ? lastCulledSprites : 0);
+            if (previous == RUNNING && gameState == GAME_OVER)
+                recorder.restart();
+        }
+    }
+
+    // Os frames ainda na fila do renderizador contam para o tempo total
+    renderThread.waitPresented(renderThread.published());
+
+    for (bool &key : keys)
+        key = false;
+    return recorder.finish();
+}
+
+// Troca o estado do jogo
+void setGameState(GameState state)
+{
+    if (state != gameState)
+    {
+        static const char *stateNames[] = {"BEFORE_START", "RUNNING", "GAME_OVER"};
+        flightRecord(FLIGHT_STATE, (uint8_t)gameState, (uint32_t)state, 0.0f, 0.0f);
+        LOG(LOG_INFO, LOG_GAME, "state %s -> %s", stateNames[gameState], stateNames[state]);
+        redrawRequested = true;
+        if (state == RUNNING)
+            gamesStarted++;
+    }
+    gameState = state;
 }
 
 // Função para resetar o jogo.
@@ -348,38 +1229,28 @@ void resetGame(Sprite &spaceship, std::vector<Sprite> &meteors)
     }
 }
 
-// Função de configuração do shader
-int setupShader()
-{
-
-    // Compilando Vertex Shader
-    GLuint vertexShader = glCreateShader(GL_VERTEX_SHADER);
-    glShaderSource(vertexShader, 1, &vertexShaderSource, nullptr);
-    glCompileShader(vertexShader);
-
-    // Compilando Fragment Shader
-    GLuint fragmentShader = glCreateShader(GL_FRAGMENT_SHADER);
-    glShaderSource(fragmentShader, 1, &fragmentShaderSource, nullptr);
-    glCompileShader(fragmentShader);
-
-    // Criando o shader program
-    GLuint shaderProgram = glCreateProgram();
-    glAttachShader(shaderProgram, vertexShader);
-    glAttachShader(shaderProgram, fragmentShader);
-    glLinkProgram(shaderProgram);
-
-    // Removendo os shaders após a vinculação
-    glDeleteShader(vertexShader);
-    glDeleteShader(fragmentShader);
-
-    return shaderProgram;
-}
-
 // Função para carregar a textura
-int loadTexture(string filePath, int &imgWidth, int &imgHeight)
+int loadTexture(string filePath, int &imgWidth, int &imgHeight, bool *opaque, SpriteOutline *outline)
 {
-
+    double decodeStart = startupTrace.nowMs();
     unsigned char *image = stbi_load(filePath.c_str(), &imgWidth, &imgHeight, 0, 4);
+    // Arquivo ausente ou corrompido: xadrez opaco no lugar (como no tools/replay), sem os passes da CPU
+    std::vector<unsigned char> checker;
+    if (!image)
+    {
+        cout << "Failed to load " << filePath << " (" << stbi_failure_reason() << "), using a checkerboard" << endl;
+        imgWidth = imgHeight = 64;
+        checker.resize((size_t)imgWidth * imgHeight * 4);
+        for (int y = 0; y < imgHeight; y++)
+            for (int x = 0; x < imgWidth; x++)
+            {
+                unsigned char c = (((x / 16) + (y / 16)) & 1) ? 255 : 64;
+                unsigned char *p = &checker[((size_t)y * imgWidth + x) * 4];
+                p[0] = p[1] = p[2] = c;
+                p[3] = 255;
+            }
+    }
+    double uploadStart = startupTrace.nowMs();
     GLuint textureID;
 
     glGenTextures(1, &textureID);
@@ -391,26 +1262,63 @@ int loadTexture(string filePath, int &imgWidth, int &imgHeight)
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
 
-    // Carregando a textura
-    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, imgWidth, imgHeight, 0, GL_RGBA, GL_UNSIGNED_BYTE, image);
+    // Carregando a textura (com alfa pré-multiplicado, a convenção de blending do Renderer)
+    if (opaque && image)
+        *opaque = isFullyOpaque(image, imgWidth, imgHeight);
+    // Contorno para a geometria recortada (a grade de frames vem preenchida em outline; sem
+    // imagem fica o quad)
+    if (outline)
+        computeSpriteOutline(image, imgWidth, imgHeight, *outline);
+    if (image)
+        premultiplyAlpha(image, imgWidth, imgHeight);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, imgWidth, imgHeight, 0, GL_RGBA, GL_UNSIGNED_BYTE, image ? image : checker.data());
     glGenerateMipmap(GL_TEXTURE_2D);
-    stbi_image_free(image);
+    if (image)
+        stbi_image_free(image);
+
+    // Sem glFinish o driver pode adiar o upload e os mipmaps para o primeiro frame
+    if (startupTrace.precise)
+        glFinish();
+    double uploadEnd = startupTrace.nowMs();
+
+    trackTexture(textureID, imgWidth, imgHeight, GL_RGBA8, mipLevelCount(imgWidth, imgHeight), filePath);
+    captureTexture(textureID, imgWidth, imgHeight, filePath);
+    hotReloader.watchTexture(filePath, textureID);
+
+    std::ifstream file(filePath, std::ios::binary | std::ios::ate);
+    size_t fileBytes = file ? (size_t)file.tellg() : 0;
+    startupTrace.asset(filePath, uploadStart - decodeStart, uploadEnd - uploadStart, fileBytes, (size_t)imgWidth * imgHeight * 4);
 
     return textureID;
 }
 
-// Função para desenhar a sprite
-void drawSprite(Sprite spr, GLuint shaderID)
+// Dados de desenho da sprite no formato do Renderer
+SpriteDraw makeSpriteDraw(const Sprite &spr, vec2 offsetTex)
 {
-    glBindTexture(GL_TEXTURE_2D, spr.texID);
-    glBindVertexArray(spr.VAO);
-
-    // Matriz de modelo
-    mat4 model = translate(mat4(1.0f), spr.position);
-    model = scale(model, spr.dimensions);
-    glUniformMatrix4fv(glGetUniformLocation(shaderID, "model"), 1, GL_FALSE, value_ptr(model));
+    SpriteDraw draw;
+    draw.texID = spr.texID;
+    draw.VAO = spr.VAO;
+    draw.vertexCount = (uint16_t)spr.vertexCount;
+    draw.position = spr.position;
+    draw.dimensions = spr.dimensions;
+    draw.offsetTex = offsetTex;
+    draw.opaque = spr.opaque;
+    // Sprite animada por tempo: só os parâmetros; o frame é escolhido na GPU
+    if (spr.framePeriod)
+    {
+        draw.animFPS = (float)(1.0 / GameClock::toSeconds(spr.framePeriod));
+        draw.animStart = animationStartSeconds(spr);
+        draw.animFrames = (uint16_t)spr.nFrames;
+        draw.animFirstFrame = (uint16_t)spr.iFrame;
+    }
+    return draw;
+}
 
-    glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
+// Função para desenhar a sprite
+// (o desenho em si acontece no Renderer, na thread de renderização)
+void submitSprite(FrameSnapshot &frame, const Sprite &spr, vec2 offsetTex)
+{
+    frame.sprites.push_back(makeSpriteDraw(spr, offsetTex));
 }
 
 // Função de callback de teclado
@@ -418,17 +1326,40 @@ void key_callback(GLFWwindow *window, int key, int scancode, int action, int mod
 {
     if (key == GLFW_KEY_ESCAPE && action == GLFW_PRESS)
         glfwSetWindowShouldClose(window, GL_TRUE);
-    if (key >= 0 && key < 1024)
+    // O estado das teclas só muda quando a simulação consome a fila (consumeInput)
+    if (key >= 0 && key < 1024 && action != GLFW_REPEAT)
+    {
+        inputQueue.push(key, action, gameClock.read());
+        LOG(LOG_TRACE, LOG_INPUT, "key %d %s", key, action == GLFW_PRESS ? "press" : "release");
+    }
+    if (action != GLFW_REPEAT)
     {
-        if (action == GLFW_PRESS)
-            keys[key] = true;
-        else if (action == GLFW_RELEASE)
-            keys[key] = false;
+        flightRecord(FLIGHT_INPUT, action == GLFW_PRESS ? 1 : 0, (uint32_t)key, 0.0f, 0.0f);
+        redrawRequested = true;
     }
+    if (key == GLFW_KEY_F1 && action == GLFW_PRESS)
+        resourceReportRequested = true;
+    if (key == GLFW_KEY_F2 && action == GLFW_PRESS)
+        flightDumpRequested = true;
+#if DEBUG_DRAW_ENABLED
+    // F3 a F5 ligam e desligam os grupos da camada de depuração
+    if (action == GLFW_PRESS && key >= GLFW_KEY_F3 && key <= GLFW_KEY_F5)
+    {
+        const uint32_t toggles[3] = {DEBUG_DRAW_AABBS, DEBUG_DRAW_PAIRS, DEBUG_DRAW_CELLS};
+        debugDrawFlags.fetch_xor(toggles[key - GLFW_KEY_F3]);
+    }
+#endif
+}
+
+// Função de callback de janela exposta
+void window_refresh_callback(GLFWwindow *window)
+{
+    redrawRequested = true;
 }
 
 // Função de configuração do sprite
-void Sprite::setupSprite(int texID, vec3 position, vec3 dimensions, int nFrames, int nAnimations, vec2 pMin, vec2 pMax)
+void Sprite::setupSprite(int texID, vec3 position, vec3 dimensions, int nFrames, int nAnimations, vec2 pMin, vec2 pMax,
+                         const SpriteOutline *outline)
 {
     this->texID = texID;
     this->dimensions = dimensions;
@@ -444,18 +1375,34 @@ void Sprite::setupSprite(int texID, vec3 position, vec3 dimensions, int nFrames,
     // Removed the manual setting of pMin and pMax from here
     // We'll call updateSpriteBounds in the main loop after modifying the position
 
-    GLfloat vertices[] = {
+    GLfloat quad[] = {
         // x    y    z    s    t
         -0.5f, -0.5f, 0.0f, 0.0f, 0.0f, // V0
         -0.5f, 0.5f, 0.0f, 0.0f, d.t,   // V1
         0.5f, -0.5f, 0.0f, d.s, 0.0f,   // V2
         0.5f, 0.5f, 0.0f, d.s, d.t      // V3
     };
+    std::vector<GLfloat> vertices(quad, quad + 20);
+
+    // Com contorno, a faixa cobre só o polígono: posição e UV saem do mesmo ponto do frame
+    if (outline && !outline->vertices.empty())
+    {
+        vertices.clear();
+        for (vec2 corner : outlineStripOrder(outline->vertices))
+        {
+            GLfloat vertex[5] = {corner.x - 0.5f, corner.y - 0.5f, 0.0f, corner.x * d.s, corner.y * d.t};
+            vertices.insert(vertices.end(), vertex, vertex + 5);
+        }
+        LOG(LOG_DEBUG, LOG_RENDER, "sprite texture %d trimmed to %d vertices, %.0f%% of the quad", texID,
+            (int)outline->vertices.size(), 100.0 * outline->area);
+    }
+    this->vertexCount = (int)(vertices.size() / 5);
+    size_t vertexBytes = vertices.size() * sizeof(GLfloat);
 
     GLuint VBO, VAO;
     glGenBuffers(1, &VBO);
     glBindBuffer(GL_ARRAY_BUFFER, VBO);
-    glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_STATIC_DRAW);
+    glBufferData(GL_ARRAY_BUFFER, vertexBytes, vertices.data(), GL_STATIC_DRAW);
 
     glGenVertexArrays(1, &VAO);
     glBindVertexArray(VAO);
@@ -469,38 +1416,108 @@ void Sprite::setupSprite(int texID, vec3 position, vec3 dimensions, int nFrames,
     glBindBuffer(GL_ARRAY_BUFFER, 0);
     glBindVertexArray(0);
     this->VAO = VAO;
+    this->VBO = VBO;
+
+    string tag = "sprite " + resourceTag(ResourceKind::Texture, texID);
+    trackBuffer(VBO, vertexBytes, tag);
+    trackVertexArray(VAO, tag);
+    captureGeometry(VAO, vertices.data(), (int)vertices.size());
     this->FPS = 12.0f;
-    this->lastTime = 0.0f;
+    this->opaque = false;
+    this->framePeriod = 0;
+    this->animStartTick = 0;
 
     // Initialize bounds
     updateSpriteBounds(*this);
 }
 
-// Função para animar a sprite, passando os diferentes frames;
-void animateSpriteByTime(Sprite &spr, GLuint &shaderId, vec2 &offsetTex, float reduceIntensityFPS)
+// Libera os recursos da sprite
+void Sprite::destroySprite()
 {
-    float now = glfwGetTime();
-    float dt = now - spr.lastTime;
+    stopSpriteAnimation(*this);
+    glDeleteVertexArrays(1, &VAO);
+    glDeleteBuffers(1, &VBO);
+    glDeleteTextures(1, &texID);
+    untrack(ResourceKind::VertexArray, VAO);
+    untrack(ResourceKind::Buffer, VBO);
+    untrack(ResourceKind::Texture, texID);
+    VAO = VBO = texID = 0;
+}
 
-    if (dt >= reduceIntensityFPS / spr.FPS)
-    {
-        spr.iFrame = (spr.iFrame + 1) % spr.nFrames; // incrementando ciclicamente o indice do Frame
-        spr.lastTime = now;
-    }
-    offsetTex.s = spr.iFrame * spr.d.s;
-    offsetTex.t = 0.0;
+// Começa a animação por tempo da sprite a partir do frame atual: um frame a cada
+// reduceIntensityFPS / FPS segundos. Não há trabalho por frame na CPU; o shader calcula o frame.
+void startSpriteAnimation(Sprite &spr, float reduceIntensityFPS)
+{
+    stopSpriteAnimation(spr);
+    spr.framePeriod = GameClock::fromSeconds(reduceIntensityFPS / spr.FPS);
+    spr.animStartTick = gameClock.now();
+}
 
-    glUniform2f(glGetUniformLocation(shaderId, "offsetTex"), offsetTex.s, offsetTex.t);
+// Para a animação no frame em que ela está
+void stopSpriteAnimation(Sprite &spr)
+{
+    spr.iFrame = currentAnimationFrame(spr);
+    spr.framePeriod = 0;
+}
+
+// Frame da animação por tempo no instante atual do relógio (a mesma conta do vertex shader)
+int currentAnimationFrame(const Sprite &spr)
+{
+    if (!spr.framePeriod)
+        return spr.iFrame;
+    uint64_t elapsed = (gameClock.now() - spr.animStartTick) / spr.framePeriod;
+    return (int)((spr.iFrame + elapsed) % spr.nFrames);
+}
+
+// Início da volta atual da animação por tempo, no tempo do frame (FrameSnapshot::time): o início
+// é reduzido módulo a volta inteira (nFrames períodos) em ticks, e só a diferença pequena vira
+// float. Pode ser negativo, até uma volta antes do início da época.
+float animationStartSeconds(const Sprite &spr)
+{
+    uint64_t now = gameClock.now();
+    uint64_t phase = (now - spr.animStartTick) % (spr.framePeriod * spr.nFrames);
+    return (float)GameClock::toSeconds((int64_t)(now % ANIMATION_EPOCH_TICKS) - (int64_t)phase);
+}
+
+// Tick do GameClock da próxima troca de frame da sprite (0 se ela não estiver animada)
+uint64_t nextAnimationTick(const Sprite &spr)
+{
+    if (!spr.framePeriod)
+        return 0;
+    uint64_t elapsed = (gameClock.now() - spr.animStartTick) / spr.framePeriod;
+    return spr.animStartTick + (elapsed + 1) * spr.framePeriod;
 }
 
 // Função para animar a sprinte, passando o índice do frame;
-void animateSpriteByFrame(Sprite &spr, GLuint &shaderId, vec2 &offsetTex, int frameIndex)
+void animateSpriteByFrame(Sprite &spr, vec2 &offsetTex, int frameIndex)
 {
     spr.iFrame = frameIndex;
     offsetTex.s = spr.iFrame * spr.d.s;
     offsetTex.t = 0.0;
+}
+
+// Aplica, em ordem, os eventos de tecla ocorridos até o tempo do frame
+void consumeInput(FrameSnapshot &frame)
+{
+    for (bool &pressed : keysPressed)
+        pressed = false;
+
+    InputEvent event;
+    while (inputQueue.pop(gameClock.wallNow(), event))
+    {
+        keys[event.key] = event.action == GLFW_PRESS;
+        if (event.action == GLFW_PRESS)
+            keysPressed[event.key] = true;
+        // A latência é medida a partir do evento mais antigo refletido neste frame
+        if (frame.inputTick == 0)
+            frame.inputTick = event.tick;
+    }
+}
 
-    glUniform2f(glGetUniformLocation(shaderId, "offsetTex"), offsetTex.s, offsetTex.t);
+// Tecla pressionada agora ou em algum momento desde o frame anterior
+bool keyDown(int key)
+{
+    return keys[key] || keysPressed[key];
 }
 
 // Função para verificar colisão entre dois sprites
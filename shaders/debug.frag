@@ -0,0 +1,8 @@
+#version 400
+in vec4 debugColor;
+out vec4 color;
+void main()
+{
+    // Blending do Renderer: alfa pré-multiplicado
+    color = vec4(debugColor.rgb * debugColor.a, debugColor.a);
+}
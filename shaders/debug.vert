@@ -0,0 +1,11 @@
+#version 400
+// Triângulos da camada de depuração, já em pixels da tela
+layout(location = 0) in vec2 position;
+layout(location = 1) in vec4 vertexColor; // RGBA sem pré-multiplicar
+uniform vec2 viewSize;
+out vec4 debugColor;
+void main()
+{
+    gl_Position = vec4(position / viewSize * 2.0 - 1.0, 0.0, 1.0);
+    debugColor = vertexColor;
+}
@@ -0,0 +1,11 @@
+#version 400
+in vec3 texCoord;
+uniform sampler2DArray layers;
+out vec4 color;
+void main()
+{
+    color = texture(layers, texCoord);
+    // As camadas de estrelas são quase todas vazias: sem blending onde não há nada
+    if (color.a == 0.0)
+        discard;
+}
@@ -0,0 +1,16 @@
+#version 400
+// Uma instância por camada; o retângulo cobre a tela inteira e não precisa de vértices no buffer
+uniform vec2 viewSize;
+uniform float tileSize[3];
+uniform float scroll[3]; // deslocamento horizontal da camada em pixels, já reduzido a uma repetição
+uniform int firstLayer;  // a passada opaca desenha só a camada distante, a translúcida as demais
+out vec3 texCoord;
+void main()
+{
+    int layer = firstLayer + gl_InstanceID;
+    vec2 corner = vec2(gl_VertexID & 1, gl_VertexID >> 1);
+    // Atrás de todas as sprites, a camada distante por último
+    gl_Position = vec4(corner * 2.0 - 1.0, 0.999 - 0.0001 * float(layer), 1.0);
+    vec2 pixel = corner * viewSize;
+    texCoord = vec3((pixel.x + scroll[layer]) / tileSize[layer], 1.0 - pixel.y / tileSize[layer], layer);
+}
@@ -0,0 +1,12 @@
+#version 400
+in vec2 local;
+in vec4 particleColor;
+out vec4 color;
+void main()
+{
+    // Disco com borda suave em vez do quadrado inteiro
+    float falloff = 1.0 - dot(local, local);
+    if (falloff <= 0.0)
+        discard;
+    color = particleColor * falloff;
+}
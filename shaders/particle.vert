@@ -0,0 +1,16 @@
+#version 400
+// Uma instância por partícula; o quadrado sai de gl_VertexID
+layout(location = 0) in vec3 particle; // posição em pixels e lado do quadrado
+layout(location = 1) in vec4 tint;     // RGBA pré-multiplicado
+uniform vec2 viewSize;
+out vec2 local;
+out vec4 particleColor;
+void main()
+{
+    vec2 corner = vec2(gl_VertexID & 1, gl_VertexID >> 1) * 2.0 - 1.0;
+    vec2 pixel = particle.xy + corner * particle.z * 0.5;
+    // Na frente de todas as sprites
+    gl_Position = vec4(pixel / viewSize * 2.0 - 1.0, -0.999, 1.0);
+    local = corner;
+    particleColor = tint;
+}
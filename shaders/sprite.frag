@@ -0,0 +1,11 @@
+#version 400
+in vec2 texCoord;
+uniform sampler2D texBuffer;
+out vec4 color;
+void main()
+{
+    color = texture(texBuffer, texCoord);
+    // Fora do contorno da sprite não há o que misturar (alfa pré-multiplicado)
+    if (color.a == 0.0)
+        discard;
+}
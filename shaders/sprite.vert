@@ -0,0 +1,24 @@
+#version 400
+layout (location = 0) in vec3 position;
+layout (location = 1) in vec2 texc;
+// Por instância (um elemento por sprite no buffer de streaming do Renderer)
+layout (location = 2) in vec3 instancePosition;
+layout (location = 3) in vec3 instanceDimensions;
+layout (location = 4) in vec2 offsetTex;
+// Animação por tempo: nº de frames, frames por segundo, instante inicial e frame inicial (fps 0: parada)
+layout (location = 5) in vec4 animation;
+uniform mat4 projection;
+uniform float time;
+out vec2 texCoord;
+void main()
+{
+    gl_Position = projection * vec4(instancePosition + position * instanceDimensions, 1.0);
+    float frame = 0.0;
+    if (animation.y > 0.0)
+    {
+        // A folga evita voltar um frame por arredondamento exatamente na troca
+        float elapsed = floor(max(time - animation.z, 0.0) * animation.y + 0.001);
+        frame = mod(animation.w + elapsed, animation.x);
+    }
+    texCoord = vec2(texc.s, 1.0 - texc.t) + offsetTex + vec2(frame / animation.x, 0.0);
+}
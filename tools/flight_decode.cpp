@@ -0,0 +1,111 @@
+/*
+ * Decodificador do gravador de voo (engine/FlightRecorder.h)
+ *
+ * Uso: flight_decode [arquivo] [--summary]
+ */
+
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+#include "../engine/FlightRecorder.h"
+
+static const char *stateName(int state)
+{
+    static const char *names[] = {"BEFORE_START", "RUNNING", "GAME_OVER"};
+    return (state >= 0 && state < 3) ? names[state] : "?";
+}
+
+static const char *dumpReasonName(int reason)
+{
+    static const char *names[] = {"exit", "hotkey", "signal"};
+    return (reason >= 0 && reason < 3) ? names[reason] : "?";
+}
+
+int main(int argc, char **argv)
+{
+    const char *path = "flight-recorder.bin";
+    bool summaryOnly = false;
+    for (int i = 1; i < argc; i++)
+    {
+        if (strcmp(argv[i], "--summary") == 0)
+            summaryOnly = true;
+        else
+            path = argv[i];
+    }
+
+    FILE *file = fopen(path, "rb");
+    if (!file)
+    {
+        printf("Cannot open %s\n", path);
+        return 1;
+    }
+
+    FlightFileHeader header;
+    if (fread(&header, sizeof(header), 1, file) != 1 || memcmp(header.magic, FLIGHT_MAGIC, sizeof(header.magic)) != 0 ||
+        header.version != FLIGHT_VERSION || header.eventSize != sizeof(FlightEvent))
+    {
+        printf("%s is not a flight recorder file (version %u)\n", path, FLIGHT_VERSION);
+        fclose(file);
+        return 1;
+    }
+
+    std::vector<FlightEvent> events(header.count);
+    size_t read = header.count ? fread(events.data(), sizeof(FlightEvent), header.count, file) : 0;
+    fclose(file);
+    events.resize(read);
+
+    printf("%s: %zu events (of %llu recorded, capacity %u)\n", path, events.size(),
+           (unsigned long long)header.totalRecorded, header.capacity);
+
+    int counts[8] = {0};
+    double frameTotal = 0.0, frameWorst = 0.0;
+    uint32_t worstFrame = 0;
+    for (const FlightEvent &e : events)
+    {
+        counts[e.type < 8 ? e.type : 0]++;
+        if (e.type == FLIGHT_FRAME)
+        {
+            frameTotal += e.x;
+            if (e.x > frameWorst)
+            {
+                frameWorst = e.x;
+                worstFrame = e.frame;
+            }
+        }
+        if (summaryOnly)
+            continue;
+
+        printf("%8u %10.3fs  %-9s ", e.frame, e.timeMs / 1000.0, flightEventName(e.type));
+        switch (e.type)
+        {
+        case FLIGHT_FRAME:
+            printf("%.3f ms (work %.3f ms)\n", e.x, e.y);
+            break;
+        case FLIGHT_STATE:
+            printf("%s -> %s\n", stateName(e.arg8), stateName(e.arg32));
+            break;
+        case FLIGHT_COLLISION:
+            printf("meteor %u, ship at (%.1f, %.1f)\n", e.arg32, e.x, e.y);
+            break;
+        case FLIGHT_RESPAWN:
+            printf("meteor %u to (%.1f, %.1f)\n", e.arg32, e.x, e.y);
+            break;
+        case FLIGHT_INPUT:
+            printf("key %u %s\n", e.arg32, e.arg8 ? "pressed" : "released");
+            break;
+        case FLIGHT_DUMP:
+            printf("%s\n", dumpReasonName(e.arg8));
+            break;
+        default:
+            printf("arg8 %u arg32 %u x %g y %g\n", e.arg8, e.arg32, e.x, e.y);
+        }
+    }
+
+    printf("Summary\n");
+    for (int type = FLIGHT_FRAME; type <= FLIGHT_DUMP; type++)
+        printf("  %-10s %8d\n", flightEventName(type), counts[type]);
+    if (counts[FLIGHT_FRAME])
+        printf("  frame ms avg %.3f, worst %.3f (frame %u)\n", frameTotal / counts[FLIGHT_FRAME], frameWorst, worstFrame);
+    return 0;
+}
@@ -0,0 +1,244 @@
+/*
+ * Replayer de traces de comandos de desenho (engine/CommandCapture.h)
+ *
+ * Reproduz um trace gravado com --capture o mais rápido possível, usando o mesmo Renderer
+ * do jogo, e imprime a vazão. Serve para comparar estratégias de submissão sobre exatamente
+ * a mesma carga, sem simulação, entrada ou vsync no caminho.
+ *
+ * Uso: replay trace.bin [--loops N] [--finish] [--offscreen] [--no-persistent-map] [--single-pass] [--overdraw]
+ */
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <vector>
+
+#include <glad/glad.h>
+#include <GLFW/glfw3.h>
+#include <stb_image/stb_image.h>
+
+#include "../engine/Benchmark.h"
+#include "../engine/CommandCapture.h"
+#include "../engine/Renderer.h"
+#include "../engine/SpriteShader.h"
+
+// Recria a textura a partir do arquivo original; se ele não existir mais, usa um xadrez do mesmo
+// tamanho para que o custo de amostragem continue parecido
+static GLuint loadTraceTexture(const TraceTexture &tex)
+{
+    int width = tex.width, height = tex.height;
+    unsigned char *image = stbi_load(tex.path.c_str(), &width, &height, 0, 4);
+    std::vector<unsigned char> checker;
+    if (!image)
+    {
+        printf("Missing %s, using a %dx%d checkerboard\n", tex.path.c_str(), tex.width, tex.height);
+        width = tex.width;
+        height = tex.height;
+        checker.resize((size_t)width * height * 4);
+        for (int y = 0; y < height; y++)
+            for (int x = 0; x < width; x++)
+            {
+                unsigned char c = (((x / 16) + (y / 16)) & 1) ? 255 : 64;
+                unsigned char *p = &checker[((size_t)y * width + x) * 4];
+                p[0] = p[1] = p[2] = c;
+                p[3] = 255;
+            }
+    }
+
+    if (image)
+        premultiplyAlpha(image, width, height);
+
+    GLuint textureID;
+    glGenTextures(1, &textureID);
+    glBindTexture(GL_TEXTURE_2D, textureID);
+
+    // Mesmos parâmetros do loadTexture do jogo
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, image ? image : checker.data());
+    glGenerateMipmap(GL_TEXTURE_2D);
+    if (image)
+        stbi_image_free(image);
+    return textureID;
+}
+
+// Mesmo layout de vértice do Sprite::setupSprite: posição (3) + coordenada de textura (2)
+static GLuint createTraceGeometry(const TraceGeometry &geometry, std::vector<GLuint> &buffers)
+{
+    GLuint VBO, VAO;
+    glGenBuffers(1, &VBO);
+    glBindBuffer(GL_ARRAY_BUFFER, VBO);
+    glBufferData(GL_ARRAY_BUFFER, geometry.vertices.size() * sizeof(float), geometry.vertices.data(), GL_STATIC_DRAW);
+
+    glGenVertexArrays(1, &VAO);
+    glBindVertexArray(VAO);
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 5 * sizeof(GLfloat), (GLvoid *)0);
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, 5 * sizeof(GLfloat), (GLvoid *)(3 * sizeof(GLfloat)));
+    glEnableVertexAttribArray(1);
+
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    glBindVertexArray(0);
+    buffers.push_back(VBO);
+    return VAO;
+}
+
+int main(int argc, char **argv)
+{
+    const char *path = nullptr;
+    int loops = 1;
+    bool finish = false, offscreen = false, persistentMapping = true, layeredPasses = true, measureOverdraw = false;
+    for (int i = 1; i < argc; i++)
+    {
+        if (strcmp(argv[i], "--loops") == 0 && i + 1 < argc)
+            loops = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--finish") == 0)
+            finish = true;
+        else if (strcmp(argv[i], "--offscreen") == 0)
+            offscreen = true;
+        else if (strcmp(argv[i], "--no-persistent-map") == 0)
+            persistentMapping = false;
+        else if (strcmp(argv[i], "--single-pass") == 0)
+            layeredPasses = false;
+        else if (strcmp(argv[i], "--overdraw") == 0)
+            measureOverdraw = true;
+        else if (argv[i][0] != '-' && !path)
+            path = argv[i];
+        else
+        {
+            printf("Usage: %s trace.bin [--loops N] [--finish] [--offscreen] [--no-persistent-map] [--single-pass] [--overdraw]\n", argv[0]);
+            return 1;
+        }
+    }
+    if (!path || loops < 1)
+    {
+        printf("Usage: %s trace.bin [--loops N] [--finish] [--offscreen] [--no-persistent-map] [--single-pass] [--overdraw]\n", argv[0]);
+        return 1;
+    }
+
+    CommandTrace trace;
+    if (!loadTrace(path, trace))
+        return 1;
+
+    if (offscreen)
+        glfwInitHint(GLFW_PLATFORM, GLFW_PLATFORM_NULL);
+    if (!glfwInit())
+    {
+        printf("Failed to initialize GLFW\n");
+        return 1;
+    }
+
+    // Mesmo contexto do jogo, com a janela oculta
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
+    glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+#ifdef __APPLE__
+    glfwWindowHint(GLFW_OPENGL_FORWARD_COMPAT, GL_TRUE);
+#endif
+    glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+    glfwWindowHint(GLFW_STENCIL_BITS, 8);
+    if (offscreen)
+        glfwWindowHint(GLFW_CONTEXT_CREATION_API, GLFW_OSMESA_CONTEXT_API);
+
+    GLFWwindow *window = glfwCreateWindow((int)trace.viewWidth, (int)trace.viewHeight, "Replay", nullptr, nullptr);
+    if (!window)
+    {
+        printf("Failed to create GLFW window\n");
+        glfwTerminate();
+        return 1;
+    }
+    glfwMakeContextCurrent(window);
+    if (!gladLoadGLLoader((GLADloadproc)glfwGetProcAddress))
+    {
+        printf("Failed to initialize GLAD\n");
+        glfwTerminate();
+        return 1;
+    }
+    glfwSwapInterval(0);
+
+    int fbWidth, fbHeight;
+    glfwGetFramebufferSize(window, &fbWidth, &fbHeight);
+    glViewport(0, 0, fbWidth, fbHeight);
+
+    // Recursos recriados, com os ids da sessão gravada mapeados para os novos
+    std::map<GLuint, GLuint> textureIds, vaoIds;
+    std::map<GLuint, uint16_t> vertexCounts; // pelo id gravado: a faixa tem 5 floats por vértice
+    std::vector<GLuint> buffers;
+    for (const TraceTexture &tex : trace.textures)
+        textureIds[tex.id] = loadTraceTexture(tex);
+    for (const TraceGeometry &geometry : trace.geometries)
+    {
+        vaoIds[geometry.vao] = createTraceGeometry(geometry, buffers);
+        vertexCounts[geometry.vao] = (uint16_t)(geometry.vertices.size() / 5);
+    }
+
+    size_t drawCount = 0;
+    for (FrameSnapshot &frame : trace.frames)
+    {
+        for (SpriteDraw &spr : frame.sprites)
+        {
+            spr.texID = textureIds[spr.texID];
+            spr.vertexCount = vertexCounts[spr.VAO];
+            spr.VAO = vaoIds[spr.VAO];
+        }
+        drawCount += frame.sprites.size();
+    }
+
+    GLuint shaderID = setupShader();
+    if (!shaderID)
+    {
+        glfwTerminate();
+        return 1;
+    }
+    Renderer renderer;
+    renderer.allowPersistentMapping = persistentMapping;
+    renderer.layeredPasses = layeredPasses;
+    renderer.measureOverdraw = measureOverdraw;
+    renderer.setup(shaderID, trace.viewWidth, trace.viewHeight);
+
+    printf("Replaying %s: %zu frames, %zu draws, %zu textures, %zu geometries, %d loop(s)\n", path,
+           trace.frames.size(), drawCount, trace.textures.size(), trace.geometries.size(), loops);
+
+    std::vector<double> frameMs;
+    frameMs.reserve(trace.frames.size() * loops);
+    double start = monotonicSeconds();
+    for (int loop = 0; loop < loops; loop++)
+    {
+        for (const FrameSnapshot &frame : trace.frames)
+        {
+            double frameStart = monotonicSeconds();
+            renderer.renderFrame(frame);
+            glfwSwapBuffers(window);
+            if (finish)
+                glFinish();
+            frameMs.push_back((monotonicSeconds() - frameStart) * 1000.0);
+        }
+        glfwPollEvents();
+    }
+    glFinish();
+    double elapsed = monotonicSeconds() - start;
+
+    double total = 0.0;
+    for (double ms : frameMs)
+        total += ms;
+    double frames = (double)frameMs.size();
+    printf("frames/s: %.1f  draws/s: %.0f  avg: %.3f ms  p50: %.3f ms  p99: %.3f ms%s\n",
+           frames / elapsed, drawCount * loops / elapsed, total / frames,
+           percentile(frameMs, 50.0), percentile(frameMs, 99.0), finish ? "" : " (CPU submit, no glFinish)");
+    renderer.instanceStream().printSummary();
+    renderer.printOverdrawSummary();
+
+    for (auto &entry : vaoIds)
+        glDeleteVertexArrays(1, &entry.second);
+    glDeleteBuffers((GLsizei)buffers.size(), buffers.data());
+    for (auto &entry : textureIds)
+        glDeleteTextures(1, &entry.second);
+    renderer.destroy();
+    glDeleteProgram(shaderID);
+    glfwTerminate();
+    return 0;
+}